@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "MainPlayerController.generated.h"
+
+UCLASS()
+class BCR_API AMainPlayerController : public APlayerController
+{
+	GENERATED_BODY()
+
+public:
+	AMainPlayerController();
+};
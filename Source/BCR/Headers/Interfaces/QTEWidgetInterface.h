@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "QTEWidgetInterface.generated.h"
+
+class UQTEViewModel;
+
+/* Implemented by QTE widgets (FQTEConfiguration::WidgetClass) pooled by the QTE subsystem */
+UINTERFACE(MinimalAPI, Blueprintable)
+class UQTEWidgetInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class BCR_API IQTEWidgetInterface
+{
+	GENERATED_BODY()
+
+public:
+	/* The widget was taken from the pool for a new session: read its state from ViewModel */
+	UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
+	void BindViewModel(UQTEViewModel* ViewModel);
+
+	/* The session ended and the widget goes back to the pool: unbind and reset animations */
+	UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
+	void UnbindViewModel();
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionBuffer.generated.h"
+
+/* Gameplay actions going through FActionBuffer */
+UENUM(BlueprintType)
+enum class EBufferedAction : uint8
+{
+	PickUp,
+	Interact,
+	Count UMETA(Hidden)
+};
+
+/* Timing of one buffered action */
+USTRUCT(BlueprintType)
+struct FBufferedActionSettings
+{
+	GENERATED_BODY()
+
+	/* A press that can't be performed yet is kept this long (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0"))
+	float bufferWindow = 0.2f;
+
+	/* Minimum time between two performed actions (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0"))
+	float cooldown = 0.15f;
+};
+
+/**
+ * Edge-triggered buffer for gameplay actions: one press performs at most one action.
+ * A press that can't be performed right away (nothing focused yet, cooldown) is retried until its buffer window ends.
+ */
+class BCR_API FActionBuffer
+{
+public:
+	void Press(EBufferedAction Action, double Now);
+
+	/* True if a press of Action is pending and out of cooldown: the caller tries to perform it */
+	bool IsPending(EBufferedAction Action, double Now, const FBufferedActionSettings& Settings) const;
+
+	/* The pending press was performed: clears it and starts the cooldown */
+	void Consume(EBufferedAction Action, double Now);
+
+	/* Drops presses older than their buffer window */
+	void Expire(double Now, TFunctionRef<const FBufferedActionSettings&(EBufferedAction)> GetSettings);
+
+	void Reset();
+
+private:
+	static constexpr int32 NumActions = static_cast<int32>(EBufferedAction::Count);
+
+	/* Time of the pending press (-1: none) and of the last performed action */
+	double pressTimes[NumActions] = { -1.0, -1.0 };
+	double performTimes[NumActions] = { -TNumericLimits<float>::Max(), -TNumericLimits<float>::Max() };
+};
@@ -4,12 +4,14 @@
 #include "GameFramework/Character.h"
 #include "Logging/LogMacros.h"
 #include "BCR/Headers/Interfaces/BCR_Helper.h"
+#include "BCR/Headers/Player/ActionBuffer.h"
 #include "MainPlayer.generated.h"
 
 class USpringArmComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
+class UInteractionFocusComponent;
 struct FInputActionValue;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
@@ -41,6 +43,17 @@ class BCR_API AMainPlayer : public ACharacter, public IBCR_Helper
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputAction* InteractAction;
 
+	/** Buffer window and cooldown of each action, shared by every player (config) */
+	UPROPERTY(EditDefaultsOnly, Config, Category = Input, meta = (AllowPrivateAccess = "true"))
+	FBufferedActionSettings PickUpSettings;
+
+	UPROPERTY(EditDefaultsOnly, Config, Category = Input, meta = (AllowPrivateAccess = "true"))
+	FBufferedActionSettings InteractSettings;
+
+	/** Pickable / interactable the player would act on */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Interaction, meta = (AllowPrivateAccess = "true"))
+	UInteractionFocusComponent* InteractionFocus;
+
 public:
 	AMainPlayer();
 
@@ -48,6 +61,8 @@ public:
 	
 	void Interact();
 
+	virtual void Tick(float DeltaTime) override;
+
 protected:
 
 	/** Called for movement input */
@@ -64,6 +79,17 @@ protected:
 	bool PickedUpSomething = false;
 	AActor* PickedUpObject;
 
+	/** Presses of PickUp / Interact, performed once each */
+	FActionBuffer ActionBuffer;
+
+	void OnPickUpPressed();
+	void OnInteractPressed();
+
+	/** Performs every pending press that can be performed now */
+	void ProcessBufferedActions();
+	bool TryPerform(EBufferedAction Action);
+	const FBufferedActionSettings& GetActionSettings(EBufferedAction Action) const;
+
 protected:
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
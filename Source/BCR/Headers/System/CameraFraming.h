@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Camera description used to frame a set of points */
+struct FCameraFramingSettings
+{
+	/* Horizontal screen axis and ground direction pointing back toward the camera */
+	FVector RightAxis = FVector::RightVector;
+	FVector BackAxis = FVector::BackwardVector;
+	/* Camera pitch in degrees (negative: looking down) */
+	float Pitch = 0.f;
+	float HorizontalFOV = 90.f;
+	float VerticalFOV = 60.f;
+	float HorizontalBuffer = 0.f;
+	float VerticalBuffer = 0.f;
+	float MinimumArmLength = 0.f;
+};
+
+struct FCameraFramingResult
+{
+	/* Weighted average of the points */
+	FVector Centroid = FVector::ZeroVector;
+	/* Distance between the two farthest points projected on each ground axis */
+	float HorizontalSpread = 0.f;
+	float VerticalSpread = 0.f;
+	/* Arm length needed by each FOV, and the one to use */
+	float HorizontalArmLength = 0.f;
+	float VerticalArmLength = 0.f;
+	float ArmLength = 0.f;
+};
+
+/**
+ * Closed-form framing of any number of weighted points (XYZ = position, W = weight).
+ * Weights only move the centroid: every point is kept on screen. A single pass over the packed array.
+ */
+struct BCR_API FCameraFraming
+{
+	static FCameraFramingResult Solve(TConstArrayView<FVector4> Points, const FCameraFramingSettings& Settings);
+};
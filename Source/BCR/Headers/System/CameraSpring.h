@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Critically damped spring stepped in closed form: for a fixed target the result only depends on the elapsed time,
+ * not on how it is split into frames (30, 60 or 144 FPS give the same trajectory).
+ * With a substep limit, a long frame (hitch) is split into equal substeps and the target is interpolated across them.
+ */
+template <typename T>
+struct TCameraSpring
+{
+	T Value = T(0);
+	T Velocity = T(0);
+	T Target = T(0);
+	bool bIsInitialized = false;
+
+	/* Jumps to the target, at rest */
+	void Snap(const T& InTarget)
+	{
+		Value = InTarget;
+		Target = InTarget;
+		Velocity = T(0);
+		bIsInitialized = true;
+	}
+
+	/* SmoothTime: seconds to roughly reach the target (0: snap). MaxSubstep <= 0: a single step whatever DeltaTime */
+	const T& Update(const T& InTarget, float SmoothTime, float DeltaTime, float MaxSubstep = 0.f)
+	{
+		if (!bIsInitialized || SmoothTime <= 0.f)
+		{
+			Snap(InTarget);
+			return Value;
+		}
+
+		const int32 NumSteps = MaxSubstep > 0.f ? FMath::Max(1, FMath::CeilToInt32(DeltaTime / MaxSubstep)) : 1;
+		const float StepTime = DeltaTime / NumSteps;
+		const T StartTarget = Target;
+		for (int32 Step = 1; Step <= NumSteps; ++Step)
+		{
+			Integrate(NumSteps == 1 ? InTarget : FMath::Lerp(StartTarget, InTarget, static_cast<float>(Step) / NumSteps), SmoothTime, StepTime);
+		}
+		Target = InTarget;
+		return Value;
+	}
+
+private:
+	void Integrate(const T& StepTarget, float SmoothTime, float StepTime)
+	{
+		// x(t) = target + (x0 + (v0 + w x0) t) e^(-w t), x relative to the target
+		const float Omega = 2.f / SmoothTime;
+		const float Decay = FMath::Exp(-Omega * StepTime);
+		const T Offset = Value - StepTarget;
+		const T Temp = (Velocity + Offset * Omega) * StepTime;
+
+		Value = StepTarget + (Offset + Temp) * Decay;
+		Velocity = (Velocity - Temp * Omega) * Decay;
+	}
+};
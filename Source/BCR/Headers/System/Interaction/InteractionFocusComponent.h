@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "BCR/Headers/System/Interaction/InteractionIndex.h"
+#include "InteractionFocusComponent.generated.h"
+
+UDELEGATE()
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteractionFocusChangedSignature, AActor*, _pickable, AActor*, _interactable);
+
+/**
+ * Keeps the best pickable and the best interactable around its owner, ranked by distance and facing.
+ * Candidates come from UInteractionIndex and are scored a few per frame; the current focus is rescored every frame,
+ * so a button press acts on the cached focus without any query.
+ *
+ * Optional line of sight is checked with one async trace each time a new candidate is ranked: the trace requested
+ * in frame N runs with the world, and its answer is read at the start of this component's tick in frame N+1.
+ * A candidate is therefore exposed one frame after it was ranked, and only if the answer is about that same actor;
+ * the answer then holds while the candidate stays ranked. Interaction.AsyncTraces 0 traces synchronously
+ * in the same frame instead (tests).
+ */
+UCLASS(ClassGroup = (Interaction), meta = (BlueprintSpawnableComponent))
+class BCR_API UInteractionFocusComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInteractionFocusComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	AActor* GetFocusedPickable() const { return published[0].Get(); }
+
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	AActor* GetFocusedInteractable() const { return published[1].Get(); }
+
+	/* For highlights and prompts */
+	UPROPERTY(BlueprintAssignable, Category = "Interaction")
+	FOnInteractionFocusChangedSignature OnFocusChanged;
+
+	/* Reach around the owner */
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	float radius = 150.0f;
+
+	/* 0: distance only, 1: an object behind counts as one radius further away */
+	UPROPERTY(EditAnywhere, Category = "Interaction", meta = (ClampMin = "0"))
+	float facingWeight = 0.5f;
+
+	/* Candidates scored per frame */
+	UPROPERTY(EditAnywhere, Category = "Interaction", meta = (ClampMin = "1"))
+	int32 candidatesPerFrame = 4;
+
+	/* Objects hidden behind rocks or walls can't be focused (off: the former detection had no such check) */
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	bool bRequireLineOfSight = false;
+
+private:
+	struct FFocusSlot
+	{
+		TWeakObjectPtr<AActor> Actor;
+		float Score = MAX_flt;
+		float Radius = 0.0f;
+	};
+
+	/* Lower is better, MAX_flt when out of reach */
+	float Score(const AActor* Candidate, float CandidateRadius) const;
+
+	/* Ranked actor if it is visible from the owner (see the class comment for the async contract) */
+	AActor* ResolveVisibility(int32 Slot, AActor* Ranked);
+	FCollisionQueryParams MakeTraceParams(const AActor* Target) const;
+
+	void PublishFocus(AActor* Pickable, AActor* Interactable);
+
+	TArray<FInteractionCandidate> candidates;
+	int32 cursor = 0;
+
+	/* Index 0: pickable, 1: interactable */
+	FFocusSlot focus[2];
+	/* Best of the pass in progress, becomes the focus when the pass ends */
+	FFocusSlot pass[2];
+
+	/* Pending visibility trace per slot and the actor it was requested for */
+	FTraceHandle visibilityTraces[2];
+	TWeakObjectPtr<AActor> tracedActors[2];
+	/* Last answered trace per slot, reused while the same actor stays ranked */
+	TWeakObjectPtr<AActor> answeredActors[2];
+	bool bAnsweredVisible[2] = { false, false };
+
+	/* Ranked and visible: what presses act on */
+	TWeakObjectPtr<AActor> published[2];
+};
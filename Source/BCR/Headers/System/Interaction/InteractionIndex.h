@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "Components/SceneComponent.h"
+#include "InteractionIndex.generated.h"
+
+/* Interfaces an indexed actor implements, computed once at registration */
+enum class EInteractionType : uint8
+{
+	None = 0,
+	Pickable = 1 << 0,
+	Interactable = 1 << 1
+};
+ENUM_CLASS_FLAGS(EInteractionType);
+
+/* Candidate returned by UInteractionIndex::GatherCandidates */
+struct FInteractionCandidate
+{
+	TWeakObjectPtr<AActor> Actor;
+	EInteractionType Type = EInteractionType::None;
+	float Radius = 0.0f;
+};
+
+struct FInteractionEntry
+{
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+	/* Horizontal bounds radius: large actors (machines) are reachable from their edge */
+	float Radius = 0.0f;
+	EInteractionType Type = EInteractionType::None;
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint MaxCell = FIntPoint::ZeroValue;
+};
+
+/**
+ * Uniform hash grid of every pickable and interactable actor of the world.
+ * Actors implementing IIPickable or IInteractable are registered when the world starts, when they spawn
+ * or when their streamed level is added, and removed at EndPlay or with their level.
+ * Movable actors follow their root component, so items pushed by physics change cells as they roll;
+ * carried items are unregistered until dropped.
+ * A candidate query only visits the few cells around the query point, whatever the number of actors.
+ */
+UCLASS()
+class BCR_API UInteractionIndex : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UInteractionIndex* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/* Adds the actor if it implements a supported interface, or refreshes its location */
+	void UpdateActor(AActor* Actor);
+	void Unregister(const AActor* Actor);
+
+	/* Every actor of the given types whose cells overlap the query square, each reported once (not distance filtered) */
+	void GatherCandidates(const FVector& Origin, float Radius, EInteractionType Types, const AActor* Ignore, TArray<FInteractionCandidate>& OutCandidates) const;
+
+	bool Contains(const AActor* Actor) const { return EntryIndices.Contains(Actor); }
+
+	int32 GetNum() const { return Entries.Num(); }
+
+private:
+	void OnActorSpawned(AActor* Actor);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+	void OnRootMoved(USceneComponent* Root, EUpdateTransformFlags Flags, ETeleportType Teleport);
+
+	UFUNCTION()
+	void OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	FIntPoint ToCell(const FVector& Location) const;
+	void LinkCells(int32 EntryIndex);
+	void UnlinkCells(int32 EntryIndex);
+
+	TSparseArray<FInteractionEntry> Entries;
+	TMap<const AActor*, int32> EntryIndices;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
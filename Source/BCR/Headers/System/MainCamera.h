@@ -7,8 +7,16 @@
 #include <GameFramework/SpringArmComponent.h>
 #include <Components/SphereComponent.h>
 #include "GameFramework/Character.h"
+#include "BCR/Headers/System/CameraFraming.h"
+#include "BCR/Headers/System/CameraSpring.h"
+#include "Camera/CameraTypes.h"
 #include "MainCamera.generated.h"
 
+/**
+ * Shared camera framing every player. It does not tick: AMainCameraManager asks for the view once per frame,
+ * after all actors (and character movement) have ticked, and the result is written to the view directly
+ * instead of moving the actor and its spring arm.
+ */
 UCLASS()
 class BCR_API AMainCamera : public AActor
 {
@@ -37,9 +45,9 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+public:
+	/** Final view of this frame; computed on the first call of a frame, later calls (other local players) reuse it */
+	void ComputeView(float DeltaTime, FMinimalViewInfo& OutPOV);
 
 public:
 	/** Returns CameraBoom subobject **/
@@ -101,25 +109,82 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parameters|Tilt shift")
 	float BlurMultiplier = 1.f;
 
+	/** Seconds to catch up with the target (critically damped, 0 = snap) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parameters|Smoothing", meta = (UIMin = 0.f))
+	float PositionSmoothTime = 0.3f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parameters|Smoothing", meta = (UIMin = 0.f))
+	float ArmLengthSmoothTime = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parameters|Smoothing", meta = (UIMin = 0.f))
+	float PitchSmoothTime = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parameters|Smoothing", meta = (UIMin = 0.f))
+	float ApertureSmoothTime = 0.3f;
+
+	/** Splits long frames (hitches) into substeps of at most this length, 0 = off */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parameters|Smoothing", meta = (UIMin = 0.f))
+	float MaxSubstepTime = 1.f / 30.f;
+
 // Private variables
 private:
 
-	TArray<ACharacter*> Players;
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ACharacter>> Players;
 	float CameraBaseHeight = 0.f;
 
+	/** Extra points kept on screen (e.g. the machine running a QTE), with their pull on the centroid */
+	TArray<TPair<TWeakObjectPtr<AActor>, float>> FramingTargets;
+
+	/** Players then targets, XYZ = location, W = weight (rebuilt each frame, memory kept) */
+	TArray<FVector4> FramingPoints;
+
+	FCameraFramingResult Framing;
+
+	/** Framed view, the actor and its components stay where they are */
+	FVector ViewPivot = FVector::ZeroVector;
+	float ViewPitch = 0.f;
+	/** Yaw the camera was placed with in the level, only the pitch is driven by the framing */
+	float ViewYaw = 0.f;
+	float ViewArmLength = 0.f;
+
+	uint64 LastViewFrame = MAX_uint64;
+	FMinimalViewInfo LastView;
+
+	TCameraSpring<FVector> PositionSpring;
+	TCameraSpring<float> ArmLengthSpring;
+	TCameraSpring<float> PitchSpring;
+	TCameraSpring<float> ApertureSpring;
+
 //Public functions
 public:
 
 	UFUNCTION(BlueprintCallable)
 	void SetPlayers(ACharacter* Player1, ACharacter* Player2);
 
+	/** Any number of local players */
+	UFUNCTION(BlueprintCallable)
+	void SetPlayerList(const TArray<ACharacter*>& NewPlayers);
+
+	UFUNCTION(BlueprintCallable)
+	void AddFramingTarget(AActor* Target, float Weight = 1.f);
+
+	UFUNCTION(BlueprintCallable)
+	void RemoveFramingTarget(AActor* Target);
+
 private:
 
 	void InitParam();
-	void UpdatePosition();
-	void UpdateArmLenght();
-	void UpdateArmAngle();
-	void UpdateBlur(float VerticalPlayerDistance);
+	void UpdateFraming();
+	void UpdatePosition(float DeltaTime);
+	void UpdateArmLenght(float DeltaTime);
+	void UpdateArmAngle(float DeltaTime);
+	void UpdateBlur(float VerticalPlayerDistance, float DeltaTime);
+
+	FRotator GetViewRotation() const { return FRotator(ViewPitch, ViewYaw, 0.f); }
+
+	/** End of the arm pulled in front of whatever blocks the boom's probe, as the spring arm would */
+	FVector ProbeArm(const FVector& ArmOrigin, const FVector& DesiredEnd) const;
 
 	FVector2D Get2DVect(FVector vect3d);
 	float GetAlpha(float value, float min, float max);
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "MainCameraManager.generated.h"
+
+/**
+ * Builds the view from AMainCamera when it is the view target.
+ * The camera manager updates after every actor tick, so the framing sees this frame's player locations.
+ */
+UCLASS()
+class BCR_API AMainCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+};
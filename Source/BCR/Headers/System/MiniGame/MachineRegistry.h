@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BCR/Headers/System/Pickable/ItemTypeRegistry.h"
+#include "MachineRegistry.generated.h"
+
+class AMiniGameSystem;
+class APickableItem;
+
+/**
+ * Machines of the world listed by the input item types they accept.
+ * Picking up an item only notifies the machines that take that type, however many machines the level holds.
+ */
+UCLASS()
+class BCR_API UMachineRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UMachineRegistry* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	void Register(AMiniGameSystem* Machine, TConstArrayView<FItemTypeId> InputTypes);
+	void Unregister(const AMiniGameSystem* Machine, TConstArrayView<FItemTypeId> InputTypes);
+
+	/* Calls OnItemPickedUp on every machine taking the item's type */
+	void NotifyItemPickedUp(const APickableItem* Item) const;
+
+private:
+	/* Indexed by FItemTypeId */
+	TArray<TArray<TWeakObjectPtr<AMiniGameSystem>>> MachinesByType;
+};
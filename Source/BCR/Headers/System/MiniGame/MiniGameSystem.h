@@ -4,14 +4,32 @@
 #include "Delegates/Delegate.h"
 #include "BCR/Headers/System/Pickable/PickableItem.h"
 #include "BCR/Headers/Interfaces/Interactable.h"
+#include "BCR/Headers/System/QTE/QTEConfigurationTypes.h"
+#include "BCR/Headers/System/Recipe/RecipeSubsystem.h"
 #include "GameFramework/Actor.h"
 #include <Components/BoxComponent.h>
 #include <Components/BillboardComponent.h>
+#include <Components/SphereComponent.h>
 #include "MiniGameSystem.generated.h"
 
 UDELEGATE()
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEndQTESignature, bool, _resultStatus);
 
+/* Machine lifecycle, changed only by events (item inserted, player snapped, QTE finished, output spawned) */
+UENUM(BlueprintType)
+enum class EMachineState : uint8
+{
+	Idle,		/* No input item inserted */
+	Loading,	/* Some input items inserted, others missing */
+	Ready,		/* Every input item inserted, waiting for the QTE to start */
+	RunningQTE,
+	Producing,	/* Outputs queued in the production scheduler */
+	Cooldown	/* Run finished, back to Idle after cooldownTime */
+};
+
+UDELEGATE()
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMachineStateChangedSignature, EMachineState, _oldState, EMachineState, _newState);
+
 UCLASS()
 class BCR_API AMiniGameSystem : public AActor, public IInteractable
 {
@@ -20,7 +38,6 @@ class BCR_API AMiniGameSystem : public AActor, public IInteractable
 public:
 	//// Unreal
 	AMiniGameSystem();
-	virtual void Tick(float DeltaTime) override;
 
 	//// Game
 	// Setters
@@ -39,47 +56,118 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void FinishExecute(bool _success);
 
+	/* Stream the QTE config and its widget in the background so starting the QTE never blocks */
+	UFUNCTION(BlueprintCallable)
+	void PreloadQTE();
+
+	/* Called by UMachineRegistry when a player picks up an item this machine takes: preloads the QTE if it still needs it */
+	void OnItemPickedUp(const APickableItem* Item);
+
+	/* Item the recipe table makes from the items loaded so far, nullptr if none */
+	UFUNCTION(BlueprintPure)
+	TSubclassOf<APickableItem> GetCraftableItem() const;
+
+	/* Spawns output i, or ends the production run past the last output (called by UProductionScheduler) */
 	UFUNCTION()
 	void SpawnItem(int i);
 	UFUNCTION(BlueprintCallable)
 	void Reset();
 
+	UFUNCTION(BlueprintPure)
+	EMachineState GetState() const { return state; }
+
+	UPROPERTY(BlueprintAssignable)
+	FOnMachineStateChangedSignature OnStateChanged;
+
 	// Interface Methods
 	void Interact_Implementation(AMainPlayer* Player);
 	void InteractWithObject_Implementation(AMainPlayer* Player, AActor* Object);
 
-	TMap<UBillboardComponent*, AMainPlayer*> snapPointMap;
-
 private:
 	UPROPERTY(EditAnywhere)
 	TArray<TSubclassOf<APickableItem>> inputItems;
-	TArray<TSubclassOf<APickableItem>> itemList; /*Copy of inputItems*/
 	UPROPERTY(EditAnywhere)
 	TArray<TSubclassOf<APickableItem>> outputItems;
+	/* Seconds between two outputs when the recipe table gives no production time */
 	UPROPERTY(EditAnywhere)
-	UQTEConfigurationAsset* QTEConfig;
+	float productionTime = 3.0f;
+	/* Seconds spent in Cooldown after a run before accepting items again */
+	UPROPERTY(EditAnywhere)
+	float cooldownTime = 0.0f;
+
+	EMachineState state = EMachineState::Idle;
+	FTimerHandle cooldownTimer;
+
+	void SetState(EMachineState _state);
+	void EnterCooldown();
+
+	/* Item type ids of inputItems / outputItems, resolved once by the registry */
+	TArray<FItemTypeId> inputItemTypes;
+	TArray<FItemTypeId> outputItemTypes;
+
+	/* Items still needed, indexed by FItemTypeId (accepting an item is a counter decrement) */
+	TArray<int32> missingItems;
+	int32 numMissingItems = 0;
+
+	/* Signature of the items loaded since the last reset, looked up in the recipe index */
+	FRecipeSignature loadedItems;
+	/* Same items, in insertion order, to confirm the recipe found for the signature */
+	TArray<FItemTypeId> loadedItemTypes;
+
+	bool NeedsItem(FItemTypeId _type) const;
+	/* Soft reference: the config and its widget are streamed by the preloader, not with the map */
+	UPROPERTY(EditAnywhere)
+	TSoftObjectPtr<UQTEConfigurationAsset> QTEConfig;
+
+	/* Keeps the preloaded config and widget in memory while players are around */
+	TSharedPtr<FQTEPreloadRequest> QTEPreload;
+
+	/* StartExecute was requested before the config finished loading */
+	bool bStartWhenLoaded = false;
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	USceneComponent* DefaultRootComponent;
 
+	/* Snap points of the machine, index = ESnapPointType slot (extra points tagged "SnapPoint" are collected at BeginPlay) */
 	UPROPERTY(EditAnywhere)
-	UBillboardComponent* snapPlayerPoint1;
+	TArray<UBillboardComponent*> snapPoints;
 
-	UPROPERTY(EditAnywhere)
-	UBillboardComponent* snapPlayerPoint2;
+	/* Player standing on each snap point (parallel to snapPoints) */
+	UPROPERTY(Transient)
+	TArray<AMainPlayer*> snapPlayers;
 
 	UPROPERTY(EditAnywhere)
 	UBillboardComponent* outputSpawnPoint;
 
 	UPROPERTY(EditAnywhere)
 	UBoxComponent* inputBox;
-	
+
+	/* Players entering this zone start preloading the QTE */
+	UPROPERTY(EditAnywhere)
+	USphereComponent* preloadZone;
+
+	/* QTE session of this machine */
+	FQTESessionHandle QTESession;
+
+	void OnQTESessionComplete(FQTESessionHandle Session, bool bSuccess);
+
+	/* Stops the running QTE session without calling back into the machine */
+	void StopQTESession();
+
+	void OnSnapPointResult(FQTESessionHandle Session, ESnapPointType SnapPoint, bool bSuccess);
+
+	void OnQTEPreloaded();
+
+	/* Queues every output in the production scheduler */
+	void StartProduction();
+
 	UFUNCTION()
-	void OnFirstSnapPointResult(bool bSuccess);
-    
+	void OnPreloadZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
 	UFUNCTION()
-	void OnSecondSnapPointResult(bool bSuccess);
+	void OnPreloadZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "ItemTypeRegistry.generated.h"
+
+class APickableItem;
+
+/* Compact id of an item type, assigned by UItemTypeRegistry (dense: usable as an array index) */
+struct FItemTypeId
+{
+	static constexpr uint16 InvalidValue = MAX_uint16;
+
+	uint16 Value = InvalidValue;
+
+	FItemTypeId() = default;
+	explicit FItemTypeId(uint16 InValue) : Value(InValue) {}
+
+	bool IsValid() const { return Value != InvalidValue; }
+	int32 GetIndex() const { return Value; }
+
+	bool operator==(FItemTypeId Other) const { return Value == Other.Value; }
+	bool operator!=(FItemTypeId Other) const { return Value != Other.Value; }
+	friend uint32 GetTypeHash(FItemTypeId Id) { return Id.Value; }
+};
+
+/* Describes an item type shared by every pickable class referencing it */
+UCLASS(BlueprintType)
+class BCR_API UItemTypeAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
+	FString DisplayName;
+};
+
+/**
+ * Assigns each pickable class a compact item type id and a display name.
+ * Classes sharing an UItemTypeAsset (or, without one, the same legacy name) share the id.
+ * The class default object is only read the first time a class is resolved.
+ */
+UCLASS()
+class BCR_API UItemTypeRegistry : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UItemTypeRegistry* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	FItemTypeId Resolve(TSubclassOf<APickableItem> ItemClass);
+
+	/* Display name of a resolved type (empty for an invalid id) */
+	const FString& GetDisplayName(FItemTypeId Id) const;
+
+	int32 GetNumTypes() const { return DisplayNames.Num(); }
+
+private:
+	/* Cache per class, filled on first resolve */
+	TMap<TWeakObjectPtr<UClass>, FItemTypeId> ClassIds;
+
+	/* Type key (asset path or legacy name) to id */
+	TMap<FName, FItemTypeId> KeyIds;
+
+	/* Indexed by FItemTypeId */
+	TArray<FString> DisplayNames;
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "BCR/Headers/Interfaces/IPickable.h"
+#include "BCR/Headers/System/Pickable/ItemTypeRegistry.h"
 #include "PickableItem.generated.h"
 
 UCLASS()
@@ -19,14 +20,34 @@ protected:
 	virtual void BeginPlay() override;
 
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	UPROPERTY(EditAnywhere)
 	FString name;
 
 	UFUNCTION(Blueprintable)
 	FString GetItemName() const { return name; };
 
+	/* Optional shared type: classes referencing the same asset are the same item, whatever their name */
+	UPROPERTY(EditDefaultsOnly)
+	TObjectPtr<UItemTypeAsset> itemType;
+
+	const UItemTypeAsset* GetItemType() const { return itemType; }
+
+	/* Compact id resolved once per class by UItemTypeRegistry */
+	FItemTypeId GetItemTypeId() const { return itemTypeId; }
+
 	virtual void PickedUp_Implementation(AActor* _player, AActor* _object) override;
+
+	/* Pool lifecycle (UPickablePoolSubsystem): the actor stays registered, only visibility, collision, physics and tick are toggled */
+	void ActivateFromPool(const FTransform& _transform);
+	void DeactivateToPool();
+	bool IsPooled() const { return bIsPooled; }
+
+private:
+	FItemTypeId itemTypeId;
+
+	bool bIsPooled = false;
+	/* Root was simulating physics when the item was pooled */
+	bool bPooledPhysics = false;
+	/* Actor tick was enabled when the item was pooled (most pickables never tick) */
+	bool bPooledTick = false;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "PickablePool.generated.h"
+
+class APickableItem;
+
+/* Inactive items of one class */
+USTRUCT()
+struct FPickablePoolEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APickableItem>> Items;
+};
+
+/**
+ * Recycles pickable items instead of spawning and destroying them.
+ * Released items stay registered in the world, hidden and without collision, physics or tick:
+ * handing one out again only restores those, BeginPlay and component registration run once per actor.
+ */
+UCLASS()
+class BCR_API UPickablePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPickablePoolSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/* Spawns Count inactive items of this class ahead of use */
+	UFUNCTION(BlueprintCallable, Category = "Pickable")
+	void Prewarm(TSubclassOf<APickableItem> ItemClass, int32 Count);
+
+	/* Reuses an inactive item of this class, or spawns one when the pool is empty */
+	UFUNCTION(BlueprintCallable, Category = "Pickable")
+	APickableItem* Acquire(TSubclassOf<APickableItem> ItemClass, const FTransform& Transform);
+
+	/* Deactivates the item and keeps it for the next Acquire of its class */
+	UFUNCTION(BlueprintCallable, Category = "Pickable")
+	void Release(APickableItem* Item);
+
+	int32 GetNumFree(TSubclassOf<APickableItem> ItemClass) const;
+
+	/* Compares spawn/destroy with acquire/release for NumMachines machines, spawn and GC costs are logged */
+	void RunStressTest(TSubclassOf<APickableItem> ItemClass, int32 NumMachines, int32 NumCycles);
+
+private:
+	APickableItem* SpawnItem(TSubclassOf<APickableItem> ItemClass, const FTransform& Transform) const;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FPickablePoolEntry> FreeItems;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProductionScheduler.generated.h"
+
+class AMiniGameSystem;
+
+/* One pending output of a machine (OutputIndex past the last output: end of the production run) */
+struct FProductionJob
+{
+	double DueTime = 0.0;
+	TWeakObjectPtr<AMiniGameSystem> Machine;
+	int32 OutputIndex = INDEX_NONE;
+	/* Insertion order, keeps jobs due on the same frame in schedule order */
+	uint32 Sequence = 0;
+
+	bool operator<(const FProductionJob& Other) const
+	{
+		return DueTime < Other.DueTime || (DueTime == Other.DueTime && Sequence < Other.Sequence);
+	}
+};
+
+/**
+ * Factory-wide production queue: every machine's pending outputs live in one min-heap ordered by due time.
+ * Due jobs are dispatched in one batched pass per frame; a frame with nothing due costs a single comparison,
+ * whatever the number of pending jobs. The scheduler clock stops while paused.
+ */
+UCLASS()
+class BCR_API UProductionScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UProductionScheduler* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/* Queues OutputIndex of Machine, Delay seconds from now */
+	void Schedule(AMiniGameSystem* Machine, int32 OutputIndex, double Delay);
+
+	/* Drops every pending job of Machine */
+	void Cancel(const AMiniGameSystem* Machine);
+
+	UFUNCTION(BlueprintCallable, Category = "Production")
+	void SetPaused(bool bPause) { bIsPaused = bPause; }
+
+	UFUNCTION(BlueprintPure, Category = "Production")
+	bool IsPaused() const { return bIsPaused; }
+
+	UFUNCTION(BlueprintPure, Category = "Production")
+	int32 GetNumPending() const { return Jobs.Num(); }
+
+	double GetTime() const { return Clock; }
+
+private:
+	TArray<FProductionJob> Jobs;
+
+	/* Reused each frame: jobs are popped first, then dispatched, so callbacks can schedule safely */
+	TArray<FProductionJob> DueJobs;
+
+	double Clock = 0.0;
+	uint32 NextSequence = 0;
+	bool bIsPaused = false;
+};
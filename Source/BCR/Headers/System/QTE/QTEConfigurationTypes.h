@@ -4,6 +4,7 @@
 #include "InputCoreTypes.h"
 #include "Engine/DataAsset.h"
 #include "BCR/Headers/System/QTE/QTETypes.h"
+#include "BCR/Headers/System/QTE/QTEProgram.h"
 #include "QTEConfigurationTypes.generated.h"
 
 class AMainPlayer;
@@ -41,6 +42,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "QTE|Configuration")
     FQTEConfiguration Configuration;
 
-    // Simple fonction de copie/validation
-    FQTEConfiguration ToRuntimeConfig() const;
+    // Programme compilé, partagé par toutes les sessions utilisant cet asset
+    TSharedRef<const FQTEProgram> GetProgram() const;
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    void CompileProgram() const;
+
+    mutable TSharedPtr<const FQTEProgram> CompiledProgram;
 };
@@ -0,0 +1,78 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+#include "Framework/Application/IInputProcessor.h"
+
+/** 
+* @brief Type d'un événement d'input capturé
+*/
+enum class EQTEInputEventType : uint8 {
+    Pressed,
+    Released,
+    // Valeur d'un axe analogique (stick), dans AxisValue
+    Axis
+};
+
+/** 
+* @brief Input horodaté capturé pour le QTE
+*/
+struct BCR_API FQTEInputEvent {
+    FKey Key;
+    EQTEInputEventType Type = EQTEInputEventType::Pressed;
+    
+    // Index utilisateur Slate (correspond au ControllerId du LocalPlayer)
+    int32 UserIndex = INDEX_NONE;
+    
+    // Horodatage en secondes (FPlatformTime::Seconds)
+    double Timestamp = 0.0;
+
+    // Valeur de l'axe pour les événements Axis
+    float AxisValue = 0.0f;
+};
+
+/** 
+* @brief État d'input d'un snap point échantillonné à un tick (mode Polling et Rotate)
+*/
+struct BCR_API FQTEInputSample {
+    bool bIsDown = false;
+    bool bJustPressed = false;
+    bool bJustReleased = false;
+    
+    // Position du stick gauche
+    FVector2D StickPosition = FVector2D::ZeroVector;
+
+    // Mesures calculées au traitement, non enregistrées : temps de session et échantillonneur de stick
+    double Time = 0.0;
+    float AngularVelocity = 0.0f;
+    float Revolutions = 0.0f;
+    int32 Direction = 0;
+
+    // Un échantillon au repos ne peut ni valider ni faire progresser une action
+    bool IsIdle() const { return !bIsDown && !bJustPressed && !bJustReleased && StickPosition.IsZero(); }
+};
+
+DECLARE_DELEGATE_OneParam(FOnQTEInputEvent, const FQTEInputEvent&);
+
+/** 
+* @brief Préprocesseur Slate qui capture les touches avant le jeu
+*
+* Les événements ne sont jamais consommés : ils continuent vers le jeu normalement.
+*/
+class BCR_API FQTEInputProcessor : public IInputProcessor
+{
+public:
+    explicit FQTEInputProcessor(FOnQTEInputEvent InOnInputEvent);
+
+    // IInputProcessor
+    virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+    virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+    virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+    virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override;
+    virtual const TCHAR* GetDebugName() const override { return TEXT("QTEInputProcessor"); }
+
+private:
+    void Capture(const FKeyEvent& InKeyEvent, EQTEInputEventType Type) const;
+
+    FOnQTEInputEvent OnInputEvent;
+};
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "BCR/Headers/System/QTE/QTEConfigurationTypes.h"
+
+/** 
+* @brief Préchargement d'un asset QTE et de son widget
+*
+* L'asset et le widget restent en mémoire tant qu'une référence à la requête existe.
+*/
+struct BCR_API FQTEPreloadRequest {
+    TSoftObjectPtr<UQTEConfigurationAsset> Config;
+
+    TSharedPtr<FStreamableHandle> ConfigHandle;
+    TSharedPtr<FStreamableHandle> WidgetHandle;
+
+    bool bIsLoaded = false;
+
+    // Durée du chargement asynchrone (mesure du temps retiré du chargement de la map)
+    double RequestTime = 0.0;
+    double LoadDuration = 0.0;
+
+    FSimpleMulticastDelegate OnLoaded;
+};
+
+/** 
+* @brief Chargement asynchrone des assets QTE référencés en soft
+*
+* Les machines qui partagent un asset partagent la même requête : il n'est chargé qu'une fois.
+*/
+class BCR_API FQTEPreloader
+{
+public:
+    // Démarre (ou rejoint) le préchargement ; OnLoaded est appelé tout de suite si tout est déjà chargé
+    TSharedPtr<FQTEPreloadRequest> Preload(const TSoftObjectPtr<UQTEConfigurationAsset>& Config, FSimpleDelegate OnLoaded);
+
+    // Liste les assets gardés en mémoire (taille estimée, durée de chargement) : mesure avant/après sur une map
+    void LogReport() const;
+
+    // Chargement asynchrone isolé (ex : widget d'une session démarrée sans préchargement)
+    TSharedPtr<FStreamableHandle> LoadAsync(const FSoftObjectPath& Path, FStreamableDelegate OnLoaded)
+    {
+        return StreamableManager.RequestAsyncLoad(Path, MoveTemp(OnLoaded));
+    }
+
+private:
+    void OnConfigLoaded(TWeakPtr<FQTEPreloadRequest> WeakRequest);
+    void OnWidgetLoaded(TWeakPtr<FQTEPreloadRequest> WeakRequest);
+
+    FStreamableManager StreamableManager;
+    TMap<FSoftObjectPath, TWeakPtr<FQTEPreloadRequest>> Requests;
+};
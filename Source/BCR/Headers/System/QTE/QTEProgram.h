@@ -0,0 +1,105 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "BCR/Headers/System/QTE/QTETypes.h"
+#include "BCR/Headers/System/QTE/QTEInputProcessor.h"
+
+// Validation d'un échantillon de l'état du joueur (mode Polling, et Rotate dans tous les modes), retourne le nombre de succès
+using FQTEPollValidator = int32 (*)(const FQTEInputSample& Sample, const FSnapPointConfig& Config, FQTEProgressData& Progress);
+
+// Validation d'un événement d'input (mode Events), retourne le nombre de succès
+using FQTEEventValidator = int32 (*)(const FQTEInputEvent& Event, FQTEProgressData& Progress);
+
+/**
+* @brief Snap point compilé : configuration et validateurs pré-résolus
+*/
+struct FQTECompiledSnapPoint
+{
+    FSnapPointConfig Config;
+    FQTEPollValidator PollValidator = nullptr;
+    FQTEEventValidator EventValidator = nullptr;
+    bool bIsUsed = false;
+
+    // Repères temporels triés (vide : action non chronométrée)
+    TArray<double> Cues;
+
+    bool IsTimed() const { return Cues.Num() > 0; }
+};
+
+// Cibles spéciales de la table de transitions
+constexpr int32 QTEStageComplete = -1;
+constexpr int32 QTEStageFailed = -2;
+
+/**
+* @brief Étape compilée : snap points indexés et transitions résolues en index
+*/
+struct FQTECompiledStage
+{
+    FName Name;
+    float TimeLimit = -1.0f;
+
+    TStaticArray<FQTECompiledSnapPoint, QTESnapPointTypeCount> SnapPoints;
+    TArray<ESnapPointType, TInlineAllocator<QTESnapPointTypeCount>> UsedSnapPoints;
+
+    // Accès direct par type de snap point (nullptr si non utilisé dans l'étape)
+    const FQTECompiledSnapPoint* GetSnapPoint(ESnapPointType SnapPoint) const
+    {
+        const FQTECompiledSnapPoint& Compiled = SnapPoints[static_cast<int32>(SnapPoint)];
+        return Compiled.bIsUsed ? &Compiled : nullptr;
+    }
+
+    TConstArrayView<ESnapPointType> GetUsedSnapPoints() const { return UsedSnapPoints; }
+    int32 GetNumSnapPoints() const { return UsedSnapPoints.Num(); }
+};
+
+/**
+* @brief Programme QTE immuable compilé depuis une FQTEConfiguration
+*
+* Compilé une fois par asset puis partagé par référence entre toutes les sessions qui l'utilisent.
+* Une configuration sans étapes est compilée en une étape unique.
+*/
+class BCR_API FQTEProgram
+{
+public:
+    static TSharedRef<const FQTEProgram> Compile(const FQTEConfiguration& Config);
+
+    bool IsValid() const { return bIsValid; }
+    const FString& GetError() const { return Error; }
+    const FString& GetConfigurationName() const { return ConfigurationName; }
+    float GetTotalTime() const { return TotalTime; }
+    EQTEInputMode GetInputMode() const { return InputMode; }
+    const TSoftClassPtr<UUserWidget>& GetWidgetClass() const { return WidgetClass; }
+
+    // Reconstruit la configuration source (enregistrement et rejeu)
+    FQTEConfiguration MakeConfiguration() const;
+
+    // Étapes, la première est l'étape de départ
+    const FQTECompiledStage& GetStage(int32 Stage) const { return Stages[Stage]; }
+    int32 GetNumStages() const { return Stages.Num(); }
+
+    // Étape suivante, QTEStageComplete ou QTEStageFailed
+    int32 GetTransition(int32 Stage, bool bSuccess) const { return Transitions[Stage * 2 + (bSuccess ? 0 : 1)]; }
+
+    // Snap points utilisés par au moins une étape : tous doivent être occupés pour démarrer
+    bool IsParticipant(ESnapPointType SnapPoint) const { return Participants.Contains(SnapPoint); }
+    TConstArrayView<ESnapPointType> GetParticipants() const { return Participants; }
+    int32 GetNumParticipants() const { return Participants.Num(); }
+
+private:
+    bool CompileStage(const FQTEStageConfig& StageConfig, FQTECompiledStage& Stage);
+
+    FString ConfigurationName;
+    float TotalTime = -1.0f;
+    EQTEInputMode InputMode = EQTEInputMode::Polling;
+    TSoftClassPtr<UUserWidget> WidgetClass;
+
+    TArray<FQTECompiledStage> Stages;
+    // Deux entrées par étape : [réussite, échec]
+    TArray<int32> Transitions;
+    TArray<ESnapPointType, TInlineAllocator<QTESnapPointTypeCount>> Participants;
+    bool bHasStageGraph = false;
+
+    bool bIsValid = false;
+    FString Error;
+};
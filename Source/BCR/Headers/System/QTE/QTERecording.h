@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "BCR/Headers/System/QTE/QTETypes.h"
+#include "BCR/Headers/System/QTE/QTEInputProcessor.h"
+
+/** 
+* @brief Nature d'une entrée enregistrée
+*/
+enum class EQTERecordEntryType : uint8 {
+    // Échantillon traité par ProcessPlayerInput (mode Polling, Rotate)
+    Sample,
+    // Événement de touche validé (mode Events)
+    Event,
+    // Crédit d'une action Hold maintenue (mode Events)
+    HoldUpdate,
+    // Repères chronométrés dépassés sans input, constatés par le tick
+    CueExpiry,
+    // Fin de l'étape courante (réussite, échec ou temps limite dépassé)
+    StageEnd
+};
+
+/** 
+* @brief Input validé d'une session, horodaté depuis le début de l'enregistrement
+*/
+struct BCR_API FQTERecordEntry {
+    double Time = 0.0;
+    EQTERecordEntryType Type = EQTERecordEntryType::Sample;
+    ESnapPointType SnapPoint = ESnapPointType::First;
+    EQTEInputEventType EventType = EQTEInputEventType::Pressed;
+    FQTEInputSample Sample;
+
+    // StageEnd : numéro d'entrée de l'étape terminée, issue et cause
+    int32 StageSerial = 0;
+    bool bStageSucceeded = false;
+    EQTEFailureCause Cause = EQTEFailureCause::None;
+
+    friend FArchive& operator<<(FArchive& Ar, FQTERecordEntry& Entry);
+};
+
+/** 
+* @brief Flux binaire des inputs d'une session QTE, rejouable sans manette
+*
+* La configuration jouée est embarquée : un rejeu ne dépend d'aucun asset.
+*/
+class BCR_API FQTERecording
+{
+public:
+    FQTERecording();
+
+    FQTEConfiguration Configuration;
+    TArray<FQTERecordEntry> Entries;
+
+    // Résultat obtenu à la fin de la session
+    bool bSuccess = false;
+    TStaticArray<int32, QTESnapPointTypeCount> SuccessCounts;
+
+    // Origine des horodatages (non sérialisée)
+    double StartTime = 0.0;
+
+    // Enregistrement produit par un rejeu : jamais écrit sur disque
+    bool bIsReplay = false;
+
+    void AddEntry(FQTERecordEntry&& Entry, double Now);
+
+    // Même résultat et mêmes compteurs de succès
+    bool MatchesResult(const FQTERecording& Other) const;
+
+    bool SaveToFile(const FString& Path) const;
+    bool LoadFromFile(const FString& Path);
+
+    // Saved/QTE
+    static FString GetRecordingDirectory();
+
+    friend FArchive& operator<<(FArchive& Ar, FQTERecording& Recording);
+};
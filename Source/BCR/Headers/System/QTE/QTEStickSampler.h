@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+/** 
+* @brief Échantillonneur de stick pour les actions Rotate
+*
+* Les lectures du stick (une par frame ou par événement analogique) sont rééchantillonnées
+* à pas fixe dans un buffer circulaire : la vitesse angulaire et les tours mesurés ne
+* dépendent pas du framerate.
+*/
+class BCR_API FQTEStickSampler
+{
+public:
+    // Fréquence d'échantillonnage et taille de la fenêtre de mesure de la vitesse (~133 ms)
+    static constexpr double SampleInterval = 1.0 / 240.0;
+    static constexpr int32 WindowSize = 32;
+
+    // Zone morte : en dessous, la direction du stick n'est pas significative
+    static constexpr float DeadZone = 0.25f;
+
+    FQTEStickSampler();
+
+    void Reset();
+
+    // Ajoute une lecture du stick à l'instant Time (secondes, croissant)
+    void AddReading(const FVector2D& Stick, double Time);
+
+    // Vitesse angulaire signée sur la fenêtre, en tours par seconde (positif = sens trigonométrique)
+    float GetAngularVelocity() const;
+
+    // Tours accumulés (signés) depuis le début de la session
+    float GetRevolutions() const { return static_cast<float>(AccumulatedAngle / UE_DOUBLE_TWO_PI); }
+
+    // -1, 0 ou 1 selon le sens de rotation courant
+    int32 GetDirection() const;
+
+    // Le dernier échantillon est hors zone morte (une rotation est en cours de suivi)
+    bool IsTracking() const { return bWasTracking; }
+
+private:
+    void PushSample(const FVector2D& Position);
+
+    // Variation d'angle de chaque échantillon de la fenêtre (buffer circulaire)
+    TStaticArray<float, WindowSize> DeltaAngles;
+    int32 Head = 0;
+    int32 NumSamples = 0;
+    double WindowSum = 0.0;
+
+    double AccumulatedAngle = 0.0;
+    float LastAngle = 0.0f;
+    bool bWasTracking = false;
+
+    // Dernière lecture brute, base de l'interpolation vers la suivante
+    FVector2D LastReading = FVector2D::ZeroVector;
+    double LastReadingTime = 0.0;
+    double NextSampleTime = 0.0;
+    bool bHasReading = false;
+};
@@ -0,0 +1,97 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "BCR/Headers/System/QTE/QTETypes.h"
+
+/** 
+* @brief Format d'export de la télémétrie
+*/
+enum class EQTETelemetryFormat : uint8 {
+    CSV,
+    JSON
+};
+
+/** 
+* @brief Histogramme à seaux fixes (en secondes), mis à jour sans allocation
+*
+* Le dernier seau reçoit toutes les valeurs au-delà de la plage.
+*/
+struct BCR_API FQTEHistogram {
+    static constexpr int32 NumBuckets = 20;
+
+    explicit FQTEHistogram(float InBucketWidth = 0.1f);
+
+    void Add(double Value);
+
+    double GetMean() const { return Count > 0 ? Sum / Count : 0.0; }
+
+    // Percentile approché par la borne haute du seau qui l'atteint
+    float GetPercentile(float Percentile) const;
+
+    float BucketWidth;
+    TStaticArray<uint32, NumBuckets + 1> Buckets;
+    uint32 Count = 0;
+    double Sum = 0.0;
+    float Min = 0.0f;
+    float Max = 0.0f;
+};
+
+/** 
+* @brief Mesures d'un snap point, cumulées sur toutes les sessions d'une configuration
+*/
+struct BCR_API FQTESnapPointTelemetry {
+    uint32 NumPresses = 0;
+    uint32 NumCompletions = 0;
+
+    // Premier input depuis le passage en Running
+    FQTEHistogram FirstInput{ 0.1f };
+    // Écart entre deux appuis successifs
+    FQTEHistogram InterPress{ 0.025f };
+    // Complétion du snap point depuis le début de son étape
+    FQTEHistogram Completion{ 0.5f };
+};
+
+/** 
+* @brief Mesures cumulées des sessions d'une configuration
+*/
+struct BCR_API FQTEConfigurationTelemetry {
+    FString ConfigurationName;
+    uint32 NumSessions = 0;
+    uint32 NumSuccesses = 0;
+
+    // Nombre de sessions par cause de fin, indexé par EQTEFailureCause
+    TStaticArray<uint32, QTEFailureCauseCount> Failures;
+
+    // Durée totale de la session (attente des joueurs comprise)
+    FQTEHistogram Duration{ 1.0f };
+
+    TStaticArray<FQTESnapPointTelemetry, QTESnapPointTypeCount> SnapPoints;
+
+    FQTEConfigurationTelemetry();
+};
+
+/** 
+* @brief Télémétrie des sessions QTE, agrégée par configuration
+*
+* Seul le démarrage de la première session d'une configuration alloue ; les mises à jour n'allouent jamais.
+*/
+class BCR_API FQTETelemetry
+{
+public:
+    // Index stable des mesures d'une configuration
+    int32 FindOrAddConfiguration(const FString& ConfigurationName);
+    FQTEConfigurationTelemetry& GetConfiguration(int32 Index) { return Configurations[Index]; }
+
+    TConstArrayView<FQTEConfigurationTelemetry> GetConfigurations() const { return Configurations; }
+
+    void Reset();
+
+    FString ExportCSV() const;
+    FString ExportJSON() const;
+    bool ExportToFile(EQTETelemetryFormat Format, const FString& Path) const;
+
+private:
+    TArray<FQTEConfigurationTelemetry> Configurations;
+    TMap<FString, int32> ConfigurationIndices;
+};
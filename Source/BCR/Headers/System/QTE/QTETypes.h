@@ -31,13 +31,80 @@ enum class EQTEState : uint8 {
     Failed
 };
 
+/** 
+* @brief Jugement d'un input par rapport à un repère temporel
+*/
+UENUM(BlueprintType)
+enum class EQTEJudgement : uint8 {
+    Perfect     UMETA(DisplayName = "Perfect"),
+    Good        UMETA(DisplayName = "Good"),
+    Miss        UMETA(DisplayName = "Miss")
+};
+
+/** 
+* @brief Cause de fin d'une session QTE (None : réussite)
+*/
+UENUM(BlueprintType)
+enum class EQTEFailureCause : uint8 {
+    None            UMETA(DisplayName = "None"),
+    Timeout         UMETA(DisplayName = "Timeout"),
+    StageTimeout    UMETA(DisplayName = "Stage Timeout"),
+    MissedCues      UMETA(DisplayName = "Missed Cues"),
+    PlayerLeft      UMETA(DisplayName = "Player Left"),
+    Stopped         UMETA(DisplayName = "Stopped")
+};
+
+constexpr int32 QTEFailureCauseCount = 6;
+
+/** 
+* @brief Mode de capture des inputs du QTE
+*/
+UENUM(BlueprintType)
+enum class EQTEInputMode : uint8 {
+    // Lecture de l'état des touches sur un timer à intervalle fixe
+    Polling     UMETA(DisplayName = "Polling"),
+    // Inputs capturés comme événements horodatés puis mis en file
+    Events      UMETA(DisplayName = "Events")
+};
+
 /** 
 * @brief Point d'interaction sur une machine
 */
 UENUM(BlueprintType)
 enum class ESnapPointType : uint8 {
     First,
-    Second
+    Second,
+    Third,
+    Fourth
+};
+
+// Nombre de valeurs de ESnapPointType (indexation directe des snap points)
+constexpr int32 QTESnapPointTypeCount = 4;
+
+//////// STRUCTS ////////
+/** 
+* @brief Handle d'une session QTE (slot + numéro de série pour détecter la réutilisation)
+*/
+USTRUCT(BlueprintType)
+struct BCR_API FQTESessionHandle {
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 Index = INDEX_NONE;
+
+    UPROPERTY()
+    int32 Serial = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+    bool operator==(const FQTESessionHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+    bool operator!=(const FQTESessionHandle& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const FQTESessionHandle& Handle)
+    {
+        return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Serial));
+    }
 };
 
 USTRUCT()
@@ -47,11 +114,24 @@ struct FQTEProgressData
     
     int32 SuccessCount = 0;
     bool bIsComplete = false;
+
+    // Suivi d'un Hold maintenu (en temps de session)
+    bool bIsHeld = false;
+    double HoldStartTime = 0.0;
+    int32 HoldCredited = 0;
+
+    // Tours de stick déjà validés (Rotate)
+    int32 RevolutionsCredited = 0;
+
+    // Prochain repère temporel à juger, et bilan des jugements
+    int32 CueCursor = 0;
+    int32 PerfectCount = 0;
+    int32 GoodCount = 0;
+    int32 MissCount = 0;
     
     FQTEProgressData() {}
 };
 
-//////// STRUCTS ////////
 /** 
 * @brief Configuration d'un point d'interaction
 */
@@ -68,15 +148,57 @@ struct BCR_API FSnapPointConfig {
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
     FKey RequiredInput;
     
-    // Nombre de fois que l'action doit être répétée (-1 pour infini)
+    // Nombre de fois que l'action doit être répétée (-1 pour infini), en tours complets pour Rotate
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE", 
-        Meta = (ClampMin = "-1", ToolTip = "Nombre de répétitions (-1 pour infini)"))
+        Meta = (ClampMin = "-1", ToolTip = "Nombre de répétitions (-1 pour infini), tours de stick pour Rotate"))
     int32 RepeatCount = 1;
     
-    // Pour les actions de rotation uniquement : vitesse minimale requise
+    // Pour les actions de rotation uniquement : vitesse angulaire minimale en tours par seconde
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE", 
-        Meta = (EditCondition = "ActionType == EQTEActionType::Rotate"))
+        Meta = (EditCondition = "ActionType == EQTEActionType::Rotate", ClampMin = "0", Units = "Hz"))
     float MinRotationSpeed = 0.5f;
+
+    // Press/Release uniquement : instants (secondes depuis le début de l'étape) où l'input doit tomber.
+    // Si renseignés, seuls les inputs dans une fenêtre comptent, et RepeatCount est borné au nombre de repères.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE|Timing",
+        Meta = (EditCondition = "ActionType == EQTEActionType::Press || ActionType == EQTEActionType::Release"))
+    TArray<float> CueTimes;
+
+    // Écart maximal (secondes) avec le repère pour un Perfect
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE|Timing", Meta = (ClampMin = "0", Units = "s"))
+    float PerfectWindow = 0.05f;
+
+    // Écart maximal (secondes) avec le repère pour un Good, au-delà l'input est un Miss
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE|Timing", Meta = (ClampMin = "0", Units = "s"))
+    float GoodWindow = 0.15f;
+};
+
+/** 
+* @brief Étape d'une séquence QTE à plusieurs étapes
+*/
+USTRUCT(BlueprintType)
+struct BCR_API FQTEStageConfig {
+    GENERATED_BODY()
+
+    // Nom unique de l'étape, référencé par les transitions
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    FName StageName;
+
+    // Actions à réussir simultanément pendant l'étape
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    TArray<FSnapPointConfig> SnapPoints;
+
+    // Temps alloué à l'étape (-1 pour illimité), son dépassement est un échec de l'étape
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    float TimeLimit = -1.0f;
+
+    // Étape suivante en cas de réussite (None : le QTE est réussi)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    FName OnSuccess;
+
+    // Étape suivante en cas d'échec (None : le QTE est échoué)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    FName OnFailure;
 };
 
 /** 
@@ -86,17 +208,25 @@ USTRUCT(BlueprintType)
 struct BCR_API FQTEConfiguration {
     GENERATED_BODY()
 
-    // Configuration pour chaque point d'interaction
+    // Configuration pour chaque point d'interaction (séquence à une seule étape)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
     TArray<FSnapPointConfig> SnapPoints;
 
+    // Séquence à plusieurs étapes, la première est l'étape de départ (remplace SnapPoints si renseigné)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    TArray<FQTEStageConfig> Stages;
+
     // Temps total alloué pour compléter le QTE (-1 pour illimité)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
     float TotalTime = -1.0f;
 
-    // Widget à afficher pendant le QTE
+    // Mode de capture des inputs
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
+    EQTEInputMode InputMode = EQTEInputMode::Polling;
+
+    // Widget à afficher pendant le QTE (référence soft : chargé par le préchargeur, pas avec la map)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
-    TSubclassOf<UUserWidget> WidgetClass;
+    TSoftClassPtr<UUserWidget> WidgetClass;
     
     // Nom pour l'identification (optionnel)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "QTE")
@@ -118,6 +248,14 @@ struct BCR_API FQTEActionProgress {
     UPROPERTY(BlueprintReadOnly)
     FVector2D StickPosition = FVector2D::ZeroVector;
 
+    // Tours accumulés (signés, positif = sens trigonométrique) pour les actions de rotation
+    UPROPERTY(BlueprintReadOnly)
+    float Revolutions = 0.0f;
+
+    // Sens de rotation courant : 1 trigonométrique, -1 horaire, 0 à l'arrêt (actions de rotation)
+    UPROPERTY(BlueprintReadOnly)
+    int32 Direction = 0;
+
     // État actif/inactif de l'action
     UPROPERTY(BlueprintReadOnly)
     bool bIsActive = false;
@@ -0,0 +1,92 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "BCR/Headers/System/QTE/QTETypes.h"
+#include "QTEViewModel.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnQTEViewModelUpdated);
+
+/**
+* @brief État affichable d'un snap point
+*/
+USTRUCT(BlueprintType)
+struct BCR_API FQTESnapPointView {
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    bool bIsUsed = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    FQTEActionProgress Progress;
+
+    // Succès obtenus et requis dans l'étape courante
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    int32 SuccessCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    int32 RequiredCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    bool bLastResult = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    bool bHasJudgement = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    EQTEJudgement LastJudgement = EQTEJudgement::Miss;
+};
+
+/**
+* @brief View-model d'une session QTE, lu par le widget de la session
+*
+* Mis à jour par le sous-système quand l'état publié change ; OnUpdated est diffusé au plus une fois par frame.
+* Réutilisé d'une session à l'autre avec son widget : aucune allocation après la première session.
+*/
+UCLASS(BlueprintType)
+class BCR_API UQTEViewModel : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UQTEViewModel();
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    FQTESessionHandle Session;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    FString ConfigurationName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    EQTEState State = EQTEState::Inactive;
+
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    FName StageName;
+
+    // Temps restant avant l'échéance de l'étape ou du QTE (-1 : illimité), rafraîchi à chaque frame sans diffusion
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    float RemainingTime = -1.0f;
+
+    // Indexé par ESnapPointType
+    UPROPERTY(BlueprintReadOnly, Category = "QTE")
+    TArray<FQTESnapPointView> SnapPoints;
+
+    UPROPERTY(BlueprintAssignable, Category = "QTE")
+    FOnQTEViewModelUpdated OnUpdated;
+
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    FQTESnapPointView GetSnapPoint(ESnapPointType SnapPoint) const { return SnapPoints[static_cast<int32>(SnapPoint)]; }
+
+    // Prépare le view-model pour une nouvelle session (mémoire conservée)
+    void Reset(FQTESessionHandle InSession, const FString& InConfigurationName);
+
+    FQTESnapPointView& GetSnapPointView(ESnapPointType SnapPoint) { return SnapPoints[static_cast<int32>(SnapPoint)]; }
+
+    void MarkDirty() { bIsDirty = true; }
+
+    // Diffuse OnUpdated si l'état a changé depuis la dernière diffusion
+    void FlushUpdates();
+
+private:
+    bool bIsDirty = false;
+};
@@ -2,21 +2,163 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
 #include "QTETypes.h"
 #include "BCR/Headers/System/QTE/QTEConfigurationTypes.h"
+#include "BCR/Headers/System/QTE/QTEInputProcessor.h"
+#include "BCR/Headers/System/QTE/QTEPreloader.h"
+#include "BCR/Headers/System/QTE/QTEProgram.h"
+#include "BCR/Headers/System/QTE/QTERecording.h"
+#include "BCR/Headers/System/QTE/QTEStickSampler.h"
+#include "BCR/Headers/System/QTE/QTETelemetry.h"
+#include "BCR/Headers/System/QTE/QTEViewModel.h"
+#include "Blueprint/UserWidget.h"
 #include "GameFramework/PlayerController.h"
+#include "Containers/ChunkedArray.h"
 #include "QTE_Subsystem.generated.h"
 
 class AMiniGameSystem;
 class AMainPlayer;
 
 // Délégués pour communiquer les résultats
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSnapPointQTEResult, bool, bSuccess);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnQTEComplete, bool, bSuccess);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnQTEActionProgress, ESnapPointType, SnapPoint, const FQTEActionProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSnapPointQTEResult, FQTESessionHandle, Session, ESnapPointType, SnapPoint, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnQTEComplete, FQTESessionHandle, Session, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnQTEActionProgress, FQTESessionHandle, Session, ESnapPointType, SnapPoint, const FQTEActionProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnQTEStageChanged, FQTESessionHandle, Session, int32, StageIndex, FName, StageName, bool, bPreviousStageSucceeded);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnQTEJudgement, FQTESessionHandle, Session, ESnapPointType, SnapPoint, EQTEJudgement, Judgement, float, Offset);
 
+// Délégués natifs propres à une session
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnQTESessionResult, FQTESessionHandle, bool);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnQTESessionSnapPointResult, FQTESessionHandle, ESnapPointType, bool);
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnQTESessionJudgement, FQTESessionHandle, ESnapPointType, EQTEJudgement, float);
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnQTESessionStageChanged, FQTESessionHandle, int32, FName, bool);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnQTESessionProgress, FQTESessionHandle, ESnapPointType, const FQTEActionProgress&);
+
+// Fin d'un enregistrement, pour les outils (natif, toutes sessions)
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnQTERecordingFinished, const FQTERecording&);
+
+/**
+* @brief Délégués d'une session, indexés par son handle
+*/
+struct FQTESessionDelegates
+{
+    FOnQTESessionResult OnComplete;
+    FOnQTESessionSnapPointResult OnSnapPointResult;
+    FOnQTESessionProgress OnActionProgress;
+    FOnQTESessionJudgement OnJudgement;
+    FOnQTESessionStageChanged OnStageChanged;
+};
+
+/**
+* @brief État d'un snap point dans une session
+*/
+struct FQTESnapPointState
+{
+    // Joueur (optionnel) et index utilisateur pour le routage des événements
+    TWeakObjectPtr<AMainPlayer> Player;
+    int32 UserIndex = INDEX_NONE;
+    bool bIsOccupied = false;
+
+    FQTEProgressData Progress;
+
+    // Dernière position du stick reçue par événements, et mesure de rotation
+    FVector2D StickReading = FVector2D::ZeroVector;
+    FQTEStickSampler Stick;
+
+    // Dernier état calculé (lu par l'UI) et dernier état publié via les délégués
+    FQTEActionProgress LatestProgress;
+    FQTEActionProgress PublishedProgress;
+    bool bHasPublishedProgress = false;
+
+    // Dernier résultat publié : seuls les changements sont diffusés
+    bool bLastResult = false;
+
+    // Suivi de télémétrie : premier input reçu et dernier appui (temps de session)
+    bool bHasInput = false;
+    double LastPressTime = -1.0;
+};
+
+/**
+* @brief État d'une session QTE (un slot du tableau de sessions)
+*/
+struct FQTESession
+{
+    int32 Serial = 0;
+    EQTEState State = EQTEState::Inactive;
+
+    // État repris à la fin d'une pause (WaitingForPlayers ou Running)
+    EQTEState ResumeState = EQTEState::Inactive;
+
+    // Programme compilé en cours (partagé avec les autres sessions du même asset)
+    TSharedPtr<const FQTEProgram> Program;
+
+    // État par snap point, contigu et indexé par ESnapPointType
+    TStaticArray<FQTESnapPointState, QTESnapPointTypeCount> SnapPoints;
+    int32 NumOccupied = 0;
+
+    // Étape courante ; le numéro d'entrée distingue deux passages dans la même étape
+    int32 Stage = 0;
+    int32 StageSerial = 0;
+    int32 NumCompleted = 0;
+
+    // Horloge de session : avancée par le tick (dilatation comprise), arrêtée en pause
+    double Clock = 0.0;
+    double RunStartTime = 0.0;
+
+    // Origine des repères temporels (début de l'étape courante) et échéances, sur l'horloge de session (-1 : aucune)
+    double StartTime = 0.0;
+    double Deadline = -1.0;
+    double StageDeadline = -1.0;
+
+    FQTESessionDelegates Delegates;
+
+    // Enregistrement des inputs validés (QTE.Record ou rejeu)
+    TSharedPtr<FQTERecording> Recording;
+
+    // Mesures de la configuration jouée (INDEX_NONE : télémétrie désactivée, rejeu ou benchmark)
+    int32 TelemetryIndex = INDEX_NONE;
+
+    // Widget emprunté au pool et son view-model (référencés pour le GC par le sous-système)
+    TObjectPtr<UUserWidget> Widget = nullptr;
+    TObjectPtr<UQTEViewModel> ViewModel = nullptr;
+    TSharedPtr<FStreamableHandle> WidgetLoadHandle;
+
+    bool IsRunning() const { return State == EQTEState::Running || State == EQTEState::WaitingForPlayers || State == EQTEState::Paused; }
+    bool HasStarted() const { return State == EQTEState::Running || (State == EQTEState::Paused && ResumeState == EQTEState::Running); }
+};
+
+/**
+* @brief Route d'un index utilisateur vers le snap point d'une session
+*/
+struct FQTEUserRoute
+{
+    int32 SessionIndex = INDEX_NONE;
+    ESnapPointType SnapPoint = ESnapPointType::First;
+
+    bool operator==(const FQTEUserRoute& Other) const { return SessionIndex == Other.SessionIndex && SnapPoint == Other.SnapPoint; }
+};
+
+/**
+* @brief Widgets libres d'une classe
+*/
+USTRUCT()
+struct FQTEWidgetPoolEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UUserWidget>> Widgets;
+};
+
+/**
+* @brief Sous-système QTE
+*
+* Toutes les sessions avancent dans un seul tick (FTickableGameObject), exécuté après les groupes de tick
+* du monde : les inputs de la frame, lus par les PlayerControllers en TG_PrePhysics, sont traités dans la même frame.
+* Le tick ne tourne que s'il y a des sessions actives et s'arrête avec la pause du monde.
+*/
 UCLASS()
-class BCR_API UQTE_Subsystem : public UGameInstanceSubsystem
+class BCR_API UQTE_Subsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
     GENERATED_BODY()
 
@@ -24,33 +166,56 @@ public:
     // Initialisation/Deinitialisation
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
-    // Contrôle du QTE
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override;
+    virtual bool IsTickableWhenPaused() const override { return false; }
+    virtual UWorld* GetTickableGameObjectWorld() const override;
+    virtual TStatId GetStatId() const override;
+
+    // Contrôle des sessions QTE
     UFUNCTION(BlueprintCallable, Category = "QTE")
-    void StartQTEFromAsset(const UQTEConfigurationAsset* Config);
+    FQTESessionHandle StartQTEFromAsset(const UQTEConfigurationAsset* Config);
     
     UFUNCTION(BlueprintCallable, Category = "QTE")
-    void StartQTE(const FQTEConfiguration Config);
+    FQTESessionHandle StartQTE(const FQTEConfiguration Config);
+
+    // Précharge en arrière-plan un asset et son widget ; la requête retournée les garde en mémoire
+    TSharedPtr<FQTEPreloadRequest> PreloadConfiguration(const TSoftObjectPtr<UQTEConfigurationAsset>& Config, FSimpleDelegate OnLoaded = FSimpleDelegate())
+    {
+        return Preloader.Preload(Config, MoveTemp(OnLoaded));
+    }
+
+    const FQTEPreloader& GetPreloader() const { return Preloader; }
+
+    // Démarre une session depuis un programme déjà compilé (aucune copie de configuration)
+    FQTESessionHandle StartQTEProgram(const TSharedRef<const FQTEProgram>& Program);
     
     UFUNCTION(BlueprintCallable, Category = "QTE")
-    void StopQTE();
+    void StopQTE(FQTESessionHandle Session);
+
+    UFUNCTION(BlueprintCallable, Category = "QTE")
+    void StopAllQTE();
     
     UFUNCTION(BlueprintCallable, Category = "QTE")
-    void SetQTEPaused(bool bPaused);
+    void SetQTEPaused(FQTESessionHandle Session, bool bPaused);
 
     // Gestion des joueurs aux snap points
     UFUNCTION(BlueprintCallable, Category = "QTE")
-    void OnPlayerEnterSnapPoint(AMainPlayer* Player, ESnapPointType SnapPoint);
+    void OnPlayerEnterSnapPoint(FQTESessionHandle Session, AMainPlayer* Player, ESnapPointType SnapPoint);
     
     UFUNCTION(BlueprintCallable, Category = "QTE")
-    void OnPlayerLeaveSnapPoint(AMainPlayer* Player, ESnapPointType SnapPoint);
+    void OnPlayerLeaveSnapPoint(FQTESessionHandle Session, AMainPlayer* Player, ESnapPointType SnapPoint);
 
-    // Délégués pour les événements
-    UPROPERTY(BlueprintAssignable, Category = "QTE")
-    FOnSnapPointQTEResult OnSnapPointFirstResult;
-    
+    // Enregistre un utilisateur sans pawn (inputs injectés, benchmark)
+    void OnUserEnterSnapPoint(FQTESessionHandle Session, int32 UserIndex, ESnapPointType SnapPoint);
+
+    // Délégués globaux pour l'UI (toutes sessions)
     UPROPERTY(BlueprintAssignable, Category = "QTE")
-    FOnSnapPointQTEResult OnSnapPointSecondResult;
+    FOnSnapPointQTEResult OnSnapPointResult;
     
     UPROPERTY(BlueprintAssignable, Category = "QTE")
     FOnQTEComplete OnQTEComplete;
@@ -58,48 +223,156 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "QTE")
     FOnQTEActionProgress OnQTEActionProgress;
 
-    EQTEState GetCurrentState() const { return CurrentState; }
+    UPROPERTY(BlueprintAssignable, Category = "QTE")
+    FOnQTEStageChanged OnQTEStageChanged;
+
+    // Jugement d'un input chronométré ; Offset = écart en secondes avec le repère (négatif = en avance)
+    UPROPERTY(BlueprintAssignable, Category = "QTE")
+    FOnQTEJudgement OnQTEJudgement;
+
+    // Délégués d'une session (nullptr si le handle n'est plus valide)
+    FQTESessionDelegates* GetSessionDelegates(FQTESessionHandle Session);
+
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    EQTEState GetSessionState(FQTESessionHandle Session) const;
+
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    bool IsSessionRunning(FQTESessionHandle Session) const;
+
+    // Temps de session écoulé depuis le début de l'étape courante, référence des repères temporels (-1 si non démarré)
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    float GetSessionTime(FQTESessionHandle Session) const;
+
+    // Widget de la session et son view-model (nullptr sans WidgetClass ou pendant son chargement)
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    UUserWidget* GetSessionWidget(FQTESessionHandle Session) const;
+
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    UQTEViewModel* GetSessionViewModel(FQTESessionHandle Session) const;
+
+    // Nom de l'étape courante (None pour une séquence à une seule étape ou une session inactive)
+    UFUNCTION(BlueprintPure, Category = "QTE")
+    FName GetSessionStage(FQTESessionHandle Session) const;
+
+    int32 GetActiveSessionCount() const { return Sessions.Num() - FreeSlots.Num(); }
+
+    // Dernière progression calculée d'un snap point (lecture une fois par frame côté UI)
+    UFUNCTION(BlueprintCallable, Category = "QTE")
+    bool GetActionProgressSnapshot(FQTESessionHandle Session, ESnapPointType SnapPoint, FQTEActionProgress& OutProgress) const;
+
+    // File d'inputs horodatés (préprocesseur Slate ou inputs synthétiques)
+    void QueueInputEvent(const FQTEInputEvent& Event);
+
+    // Lance NumSessions sessions synthétiques et mesure le coût de la mise à jour groupée
+    void RunBenchmark(int32 NumSessions, int32 NumFrames);
+
+    // Rejoue un enregistrement en temps simulé, sans manette ; OutResult reçoit le résultat et les compteurs obtenus
+    bool ReplayRecording(const FQTERecording& Recording, FQTERecording& OutResult);
+
+    // Rejoue NumRuns fois un fichier et vérifie que chaque rejeu reproduit le résultat enregistré
+    bool RunReplay(const FString& Path, int32 NumRuns);
+
+    // Enregistrement d'une session terminée (QTE.Record), diffusé avant son écriture dans Saved/QTE
+    FOnQTERecordingFinished OnRecordingFinished;
+
+    // Télémétrie cumulée des sessions, exportée dans Saved/QTE
+    const FQTETelemetry& GetTelemetry() const { return Telemetry; }
+    bool ExportTelemetry(EQTETelemetryFormat Format);
+    void ResetTelemetry() { Telemetry.Reset(); }
+
+    // Pas de comptage des Hold : un succès par intervalle maintenu
+    static constexpr float ProcessInterval = 0.016f;
 
 private:
-    // État actuel
-    EQTEState CurrentState;
-    bool bIsPaused;
-    
-    // Configuration en cours
-    FQTEConfiguration CurrentConfig;
-    
-    // Map des joueurs actifs par snap point
-    TMap<ESnapPointType, TWeakObjectPtr<AMainPlayer>> ActivePlayers;
-    TMap<ESnapPointType, FQTEProgressData> ActionProgress;
+    // Sessions (slots réutilisés, le numéro de série invalide les anciens handles).
+    // Tableau par blocs : les adresses restent stables si un callback démarre une session.
+    TChunkedArray<FQTESession> Sessions;
+    TArray<int32> FreeSlots;
+
+    // Routage des événements : index utilisateur -> snap points occupés
+    TMultiMap<int32, FQTEUserRoute> UserRoutes;
     
-    // Timers
-    FTimerHandle GlobalTimerHandle;
-    FTimerHandle ProcessTimerHandle;
-
-    // Méthodes privées de traitement des inputs
-    void ProcessInputs(float DeltaTime);
-    void ProcessPlayerInput(AMainPlayer* Player, ESnapPointType SnapPoint, const FSnapPointConfig& Config, float DeltaTime);
-    bool ValidatePlayerAction(AMainPlayer* Player, const FSnapPointConfig& Config);
+    // Repères de la frame en cours, pour convertir les horodatages des événements en temps de session
+    double FrameRealTime = 0.0;
+    double FrameDeltaTime = 0.0;
+    double FrameTimeDilation = 1.0;
+
+    // Chargement asynchrone des assets QTE
+    FQTEPreloader Preloader;
+
+    // Pool de widgets par classe et de view-models : réutilisés d'une session à l'autre
+    UPROPERTY(Transient)
+    TMap<TObjectPtr<UClass>, FQTEWidgetPoolEntry> FreeWidgets;
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UQTEViewModel>> FreeViewModels;
+
+    // Télémétrie, et nom du fichier d'export de cette instance de jeu
+    FQTETelemetry Telemetry;
+    FString TelemetryFileName;
+
+    // Capture événementielle
+    TSharedPtr<FQTEInputProcessor> InputProcessor;
+    TArray<FQTEInputEvent> PendingInputs;
+    TArray<FQTEInputEvent> ProcessingInputs;
+
+    // Méthodes de gestion des slots
+    FQTESession* FindSession(FQTESessionHandle Handle);
+    const FQTESession* FindSession(FQTESessionHandle Handle) const;
+    FQTESessionHandle AllocateSession();
+    void ReleaseSession(int32 Index);
+    FQTESessionHandle MakeHandle(int32 Index) const;
+
+    // Méthodes privées de traitement des inputs (mise à jour groupée de toutes les sessions)
+    void ProcessInputs();
+    void ProcessPlayerInput(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, const FQTEInputSample& Sample, double Now);
+    bool ApplyActionSuccess(int32 SessionIndex, ESnapPointType SnapPoint, const FSnapPointConfig& Config, int32 Count, double Now);
+    void PublishSnapPointResult(int32 SessionIndex, ESnapPointType SnapPoint, bool bSuccess);
+    void PublishActionProgress(int32 SessionIndex, ESnapPointType SnapPoint, const FQTEActionProgress& Progress);
+    bool HasProgressChanged(const FQTESnapPointState& State, const FQTEActionProgress& Progress) const;
     
-    // Méthodes de validation par type d'action
-    bool ValidateHoldAction(const AMainPlayer* Player, const FSnapPointConfig& Config);
-    bool ValidateRotateAction(const AMainPlayer* Player, const FSnapPointConfig& Config);
-    bool ValidatePressAction(const AMainPlayer* Player, const FSnapPointConfig& Config);
-    bool ValidateReleaseAction(const AMainPlayer* Player, const FSnapPointConfig& Config);
+    // Méthodes du mode événementiel
+    void StartInputCapture();
+    void StopInputCapture();
+    void ProcessQueuedInputs();
+    void ProcessInputEvent(const FQTEInputEvent& Event);
+    void ProcessSnapPointEvent(int32 SessionIndex, ESnapPointType SnapPoint, const FQTEInputEvent& Event);
+    void RegisterParticipant(FQTESessionHandle Handle, AMainPlayer* Player, int32 UserIndex, ESnapPointType SnapPoint);
+    void UpdateHeldActions(int32 SessionIndex, double Now);
+    double ToSessionTime(const FQTESession& Session, double Timestamp) const;
+    bool CreditHeldAction(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, double Now);
+
+    // Méthodes de jugement des actions chronométrées
+    bool JudgeInput(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, double Time);
+    bool ExpireCues(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, double Time);
+    void PublishJudgement(int32 SessionIndex, ESnapPointType SnapPoint, EQTEJudgement Judgement, double Offset);
+    int32 GetPlayerUserIndex(const AMainPlayer* Player) const;
     
     // Méthodes de feedback et progression
-    void UpdateActionProgress(const AMainPlayer* Player, ESnapPointType SnapPoint, const FSnapPointConfig& Config);
+    void UpdateActionProgress(int32 SessionIndex, ESnapPointType SnapPoint, const FSnapPointConfig& Config, const FQTEInputSample& Sample);
+
+    // Méthodes du pool de widgets
+    void AcquireWidget(int32 SessionIndex);
+    void OnWidgetClassLoaded(FQTESessionHandle Handle);
+    void ReleaseWidget(FQTESession& Session);
+    void RefreshViewModel(int32 SessionIndex);
+    void FlushViewModel(FQTESession& Session);
+    FQTESnapPointView* FindSnapPointView(int32 SessionIndex, ESnapPointType SnapPoint);
+
+    // Méthodes d'enregistrement et de télémétrie
+    void RecordEntry(int32 SessionIndex, FQTERecordEntry&& Entry, double Now);
+    void FinishRecording(int32 SessionIndex, bool bSuccess);
+    void TrackInput(int32 SessionIndex, ESnapPointType SnapPoint, bool bPressed, double Now);
+    void RecordSessionTelemetry(const FQTESession& Session, EQTEFailureCause Cause);
 
     // Méthodes de gestion d'état
-    void CompleteQTE(bool bSuccess);
-    void ClearTimers();
-    void SetupTimers();
-    void ResetState();
-    void SetQTEState(EQTEState NewState);
+    void CompleteQTE(int32 SessionIndex, bool bSuccess, EQTEFailureCause Cause);
+    void EnterStage(int32 SessionIndex, int32 Stage, double Now);
+    void EndStage(int32 SessionIndex, bool bSuccess, double Now, EQTEFailureCause Cause);
+    void CheckDeadlines(int32 SessionIndex);
+    void UpdateSharedProcessing();
     
     // Méthodes de validation
-    bool IsQTERunning() const;
-    bool IsQTEConfigValid() const;
-    bool CanStartQTE() const;
-    bool CheckQTECompletion();
+    bool CanStartQTE(const FQTESession& Session) const;
+    bool CheckStageCompletion(const FQTESession& Session) const;
 };
\ No newline at end of file
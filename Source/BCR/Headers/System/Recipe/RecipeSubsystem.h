@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "BCR/Headers/System/Pickable/ItemTypeRegistry.h"
+#include "RecipeSubsystem.generated.h"
+
+class APickableItem;
+
+/* Native row layout for recipe tables (DT_Recipes uses the equivalent SRecipe blueprint struct) */
+USTRUCT(BlueprintType)
+struct FRecipeRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TArray<TSubclassOf<APickableItem>> Recipe;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TSubclassOf<APickableItem> Result;
+
+	/* Seconds between two outputs (0: machine default) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float ProductionTime = 0.0f;
+};
+
+/* Canonical signature of an ingredient multiset: order independent, updated in O(1) per item */
+struct FRecipeSignature
+{
+	uint64 Hash = 0;
+	int32 NumItems = 0;
+
+	void Add(FItemTypeId Item);
+	void Remove(FItemTypeId Item);
+	void Reset() { Hash = 0; NumItems = 0; }
+
+	bool operator==(const FRecipeSignature& Other) const { return Hash == Other.Hash && NumItems == Other.NumItems; }
+	friend uint32 GetTypeHash(const FRecipeSignature& Signature) { return GetTypeHash(Signature.Hash); }
+};
+
+/* Read-only recipe, ingredients and result class stored in the subsystem's shared arrays */
+struct FRecipe
+{
+	FName RowName;
+	FItemTypeId Result;
+	float ProductionTime = 0.0f;
+	int32 FirstIngredient = 0;
+	int32 NumIngredients = 0;
+};
+
+/**
+ * Loads the recipe table once and indexes every recipe by the signature of its ingredients.
+ * Machines keep a running FRecipeSignature of what is loaded and resolve the craftable recipe in constant time.
+ */
+UCLASS(Config = Game)
+class BCR_API URecipeSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URecipeSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/* Recipe made from exactly these ingredients, nullptr if none (Items, in any order, rule out hash collisions) */
+	const FRecipe* FindRecipe(const FRecipeSignature& Signature, TConstArrayView<FItemTypeId> Items) const;
+
+	/* Pickable class spawned by a recipe returned by FindRecipe */
+	TSubclassOf<APickableItem> GetResultClass(const FRecipe& Recipe) const;
+
+	int32 GetNumRecipes() const { return Recipes.Num(); }
+
+	/* Item crafted from these ingredients (any order), nullptr if no recipe matches */
+	UFUNCTION(BlueprintCallable, Category = "Recipe")
+	TSubclassOf<APickableItem> FindRecipeResult(const TArray<TSubclassOf<APickableItem>>& Ingredients) const;
+
+private:
+	/* Set in DefaultGame.ini */
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> RecipeTable;
+
+	void BuildIndex(const UDataTable& Table);
+
+	/* Kept loaded: result columns may be soft references resolved when the index is built */
+	UPROPERTY(Transient)
+	TObjectPtr<UDataTable> LoadedTable;
+
+	TArray<FRecipe> Recipes;
+	TArray<FItemTypeId> Ingredients;
+	TMap<FRecipeSignature, int32> RecipeIndex;
+
+	/* Parallel to Recipes, referenced here so the classes cannot be collected */
+	UPROPERTY(Transient)
+	TArray<TSubclassOf<APickableItem>> ResultClasses;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UItemTypeRegistry> ItemTypes;
+};
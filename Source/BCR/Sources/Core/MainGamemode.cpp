@@ -1,4 +1,5 @@
 #include "BCR/Headers/Core/MainGamemode.h"
+#include "BCR/Headers/Core/MainPlayerController.h"
 #include "BCR/Headers/System/MainCamera.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Kismet/GameplayStatics.h"
@@ -11,6 +12,8 @@ AMainGamemode::AMainGamemode()
 	{
 		DefaultPawnClass = PlayerPawnBPClass.Class;
 	}
+
+	PlayerControllerClass = AMainPlayerController::StaticClass();
 }
 
 void AMainGamemode::BeginPlay()
@@ -50,6 +53,16 @@ void AMainGamemode::SetupCamera()
 
 	if (AMainCamera* MainCamera = Cast<AMainCamera>(Cameras[0]))
 	{
-		MainCamera->SetPlayers(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0), UGameplayStatics::GetPlayerCharacter(GetWorld(), 1));
+		// Every local player created so far
+		TArray<ACharacter*> Players;
+		for (int32 i = 0; i < UGameplayStatics::GetNumPlayerControllers(GetWorld()); i++)
+		{
+			Players.Add(UGameplayStatics::GetPlayerCharacter(GetWorld(), i));
+			if (APlayerController* Controller = UGameplayStatics::GetPlayerController(GetWorld(), i))
+			{
+				Controller->SetViewTarget(MainCamera);
+			}
+		}
+		MainCamera->SetPlayerList(Players);
 	}
 }
@@ -0,0 +1,8 @@
+#include "BCR/Headers/Core/MainPlayerController.h"
+#include "BCR/Headers/System/MainCameraManager.h"
+
+AMainPlayerController::AMainPlayerController()
+{
+	// Shared camera framing, computed after the players have moved
+	PlayerCameraManagerClass = AMainCameraManager::StaticClass();
+}
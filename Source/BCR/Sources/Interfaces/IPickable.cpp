@@ -2,6 +2,7 @@
 
 
 #include "BCR/Headers/Interfaces/IPickable.h"
+#include "BCR/Headers/System/Interaction/InteractionIndex.h"
 
 // Add default functionality here for any IIPickable functions that are not pure virtual.
 
@@ -9,10 +10,21 @@ void IIPickable::PickedUp_Implementation(AActor* Player, AActor* Object)
 {
 	FAttachmentTransformRules rules = FAttachmentTransformRules(EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld,false);
 	Object->AttachToActor(Player, rules);
+
+	// A carried object can't be picked up by someone else
+	if (UInteractionIndex* index = UInteractionIndex::Get(Object))
+	{
+		index->Unregister(Object);
+	}
 }
 
 void IIPickable::Drop_Implementation(AActor* Player, AActor* Object)
 {
 	FDetachmentTransformRules rules = FDetachmentTransformRules(EDetachmentRule::KeepWorld, EDetachmentRule::KeepWorld, EDetachmentRule::KeepWorld, false);
 	Object->DetachFromActor(rules);
+
+	if (UInteractionIndex* index = UInteractionIndex::Get(Object))
+	{
+		index->UpdateActor(Object);
+	}
 }
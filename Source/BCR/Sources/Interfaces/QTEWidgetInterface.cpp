@@ -0,0 +1,3 @@
+#include "BCR/Headers/Interfaces/QTEWidgetInterface.h"
+
+// Add default functionality here for any IQTEWidgetInterface functions that are not pure virtual.
@@ -0,0 +1,42 @@
+#include "BCR/Headers/Player/ActionBuffer.h"
+
+void FActionBuffer::Press(EBufferedAction Action, double Now)
+{
+	// A second press while one is pending refreshes it: still a single action
+	pressTimes[static_cast<int32>(Action)] = Now;
+}
+
+bool FActionBuffer::IsPending(EBufferedAction Action, double Now, const FBufferedActionSettings& Settings) const
+{
+	const int32 index = static_cast<int32>(Action);
+	return pressTimes[index] >= 0.0
+		&& Now - pressTimes[index] <= Settings.bufferWindow
+		&& Now - performTimes[index] >= Settings.cooldown;
+}
+
+void FActionBuffer::Consume(EBufferedAction Action, double Now)
+{
+	const int32 index = static_cast<int32>(Action);
+	pressTimes[index] = -1.0;
+	performTimes[index] = Now;
+}
+
+void FActionBuffer::Expire(double Now, TFunctionRef<const FBufferedActionSettings&(EBufferedAction)> GetSettings)
+{
+	for (int32 index = 0; index < NumActions; index++)
+	{
+		if (pressTimes[index] >= 0.0 && Now - pressTimes[index] > GetSettings(static_cast<EBufferedAction>(index)).bufferWindow)
+		{
+			pressTimes[index] = -1.0;
+		}
+	}
+}
+
+void FActionBuffer::Reset()
+{
+	for (int32 index = 0; index < NumActions; index++)
+	{
+		pressTimes[index] = -1.0;
+		performTimes[index] = -TNumericLimits<float>::Max();
+	}
+}
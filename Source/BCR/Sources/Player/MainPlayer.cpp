@@ -12,6 +12,7 @@
 #include "BCR/Headers/Interfaces/IPickable.h"
 #include "BCR/Headers/Interfaces/Interactable.h"
 #include "BCR/Headers/Interfaces/BCR_Helper.h"
+#include "BCR/Headers/System/Interaction/InteractionFocusComponent.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -41,6 +42,9 @@ AMainPlayer::AMainPlayer()
 	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
 	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
 
+	// Best pickable / interactable in reach, kept up to date so presses need no query
+	InteractionFocus = CreateDefaultSubobject<UInteractionFocusComponent>(TEXT("InteractionFocus"));
+
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 }
@@ -83,8 +87,9 @@ void AMainPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponen
 		// Looking
 		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AMainPlayer::Look);
 
-		EnhancedInputComponent->BindAction(PickUpAction, ETriggerEvent::Triggered, this, &AMainPlayer::PickUp);
-		EnhancedInputComponent->BindAction(InteractAction, ETriggerEvent::Triggered, this, &AMainPlayer::Interact);
+		// Edge-triggered: holding the button does not repeat the action
+		EnhancedInputComponent->BindAction(PickUpAction, ETriggerEvent::Started, this, &AMainPlayer::OnPickUpPressed);
+		EnhancedInputComponent->BindAction(InteractAction, ETriggerEvent::Started, this, &AMainPlayer::OnInteractPressed);
 	}
 	else
 	{
@@ -124,20 +129,65 @@ void AMainPlayer::Look(const FInputActionValue& Value)
 	}
 }
 
-TArray<FHitResult> Detect_Object(AActor* Player) {
-	const FVector Pos = Player->GetActorLocation() + Player->GetActorForwardVector();
-	const FName ProfileName = "BlockAll";
-	constexpr ECollisionChannel Channel = ECC_Visibility;
-	const FCollisionShape ColCapsule = FCollisionShape::MakeBox(FVector(100));
-	const TArray<AActor*> ActorsToIgnore = { Player };
-	TArray<FHitResult> OutHits = {};
-	DrawDebugBox(Player->GetWorld(), Pos + Player->GetActorForwardVector() * 100, ColCapsule.GetBox(), Player->GetActorForwardVector().ToOrientationQuat(), FColor::Orange);
-	if (Player->GetWorld()->SweepMultiByChannel(OutHits, Pos, Pos, Player->GetActorUpVector().ToOrientationQuat(), Channel, ColCapsule))
+void AMainPlayer::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	ProcessBufferedActions();
+}
+
+void AMainPlayer::OnPickUpPressed()
+{
+	ActionBuffer.Press(EBufferedAction::PickUp, GetWorld()->GetTimeSeconds());
+	ProcessBufferedActions();
+}
+
+void AMainPlayer::OnInteractPressed()
+{
+	ActionBuffer.Press(EBufferedAction::Interact, GetWorld()->GetTimeSeconds());
+	ProcessBufferedActions();
+}
+
+const FBufferedActionSettings& AMainPlayer::GetActionSettings(EBufferedAction Action) const
+{
+	return Action == EBufferedAction::PickUp ? PickUpSettings : InteractSettings;
+}
+
+void AMainPlayer::ProcessBufferedActions()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	ActionBuffer.Expire(Now, [this](EBufferedAction Action) -> const FBufferedActionSettings& { return GetActionSettings(Action); });
+
+	for (const EBufferedAction Action : { EBufferedAction::PickUp, EBufferedAction::Interact })
 	{
-		return OutHits;
+		// Kept in the buffer while there is nothing to act on yet (e.g. still snapping to a machine)
+		if (ActionBuffer.IsPending(Action, Now, GetActionSettings(Action)) && TryPerform(Action))
+		{
+			ActionBuffer.Consume(Action, Now);
+		}
 	}
+}
 
-	return OutHits;
+bool AMainPlayer::TryPerform(EBufferedAction Action)
+{
+	switch (Action)
+	{
+	case EBufferedAction::PickUp:
+		if (!PickedUpSomething && !InteractionFocus->GetFocusedPickable()) {
+			return false;
+		}
+		PickUp();
+		return true;
+
+	case EBufferedAction::Interact:
+		if (!InteractionFocus->GetFocusedInteractable()) {
+			return false;
+		}
+		Interact();
+		return true;
+
+	default:
+		return false;
+	}
 }
 
 void AMainPlayer::PickUp() {
@@ -146,32 +196,23 @@ void AMainPlayer::PickUp() {
 		PickedUpSomething = false;
 		PickedUpObject = __nullptr;
 	}
-	else {
-		TArray<FHitResult> OutHits = Detect_Object(this);
-		for (const FHitResult OutHit : OutHits)
-		{
-			if (Cast<IIPickable>(OutHit.GetActor())) {
-				IIPickable::Execute_PickedUp(OutHit.GetActor(), this, OutHit.GetActor());
-					PickedUpSomething = true;
-				PickedUpObject = OutHit.GetActor();
-			}
-				
-		}
-		
+	else if (AActor* Target = InteractionFocus->GetFocusedPickable()) {
+		IIPickable::Execute_PickedUp(Target, this, Target);
+		PickedUpSomething = true;
+		PickedUpObject = Target;
 	}
 }
 
 void AMainPlayer::Interact() {
-	TArray<FHitResult> OutHits = Detect_Object(this);
-	for (const FHitResult OutHit : OutHits)
-	{
-		if(PickedUpObject && Cast<IInteractable>(OutHit.GetActor())){
-			IInteractable::Execute_InteractWithObject(OutHit.GetActor(), this,PickedUpObject);
-		}
-		else if (Cast<IInteractable>(OutHit.GetActor())) {
-			IInteractable::Execute_Interact(OutHit.GetActor(), this);
-
-		}
+	AActor* Target = InteractionFocus->GetFocusedInteractable();
+	if (!Target) {
+		return;
+	}
 
+	if (PickedUpObject) {
+		IInteractable::Execute_InteractWithObject(Target, this, PickedUpObject);
+	}
+	else {
+		IInteractable::Execute_Interact(Target, this);
 	}
 }
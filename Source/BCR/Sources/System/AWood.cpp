@@ -6,8 +6,8 @@
 // Sets default values
 AAWood::AAWood()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Nothing to update per frame
+	PrimaryActorTick.bCanEverTick = false;
 
 }
 
@@ -17,11 +17,3 @@ void AAWood::BeginPlay()
 	Super::BeginPlay();
 	
 }
-
-// Called every frame
-void AAWood::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
-
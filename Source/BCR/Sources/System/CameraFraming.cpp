@@ -0,0 +1,72 @@
+#include "BCR/Headers/System/CameraFraming.h"
+
+FCameraFramingResult FCameraFraming::Solve(TConstArrayView<FVector4> Points, const FCameraFramingSettings& Settings)
+{
+	FCameraFramingResult Result;
+	if (Points.Num() == 0)
+	{
+		Result.ArmLength = Settings.MinimumArmLength;
+		return Result;
+	}
+
+	// Ground axes, as the screen sees them
+	const FVector2D Right = FVector2D(Settings.RightAxis).GetSafeNormal();
+	const FVector2D Back = FVector2D(Settings.BackAxis).GetSafeNormal();
+
+	FVector WeightedSum = FVector::ZeroVector;
+	double TotalWeight = 0.0;
+	double MinRight = TNumericLimits<double>::Max(), MaxRight = TNumericLimits<double>::Lowest();
+	double MinBack = TNumericLimits<double>::Max(), MaxBack = TNumericLimits<double>::Lowest();
+
+	for (const FVector4& Point : Points)
+	{
+		WeightedSum += FVector(Point) * Point.W;
+		TotalWeight += Point.W;
+
+		const FVector2D Ground(Point.X, Point.Y);
+		const double OnRight = FVector2D::DotProduct(Right, Ground);
+		const double OnBack = FVector2D::DotProduct(Back, Ground);
+		MinRight = FMath::Min(MinRight, OnRight);
+		MaxRight = FMath::Max(MaxRight, OnRight);
+		MinBack = FMath::Min(MinBack, OnBack);
+		MaxBack = FMath::Max(MaxBack, OnBack);
+	}
+
+	if (TotalWeight > UE_SMALL_NUMBER)
+	{
+		Result.Centroid = WeightedSum / TotalWeight;
+	}
+	else
+	{
+		// No weight at all: frame the middle of the points
+		const FVector2D Mid(Right * (MinRight + MaxRight) * 0.5 + Back * (MinBack + MaxBack) * 0.5);
+		Result.Centroid = FVector(Mid, 0.0);
+		for (const FVector4& Point : Points)
+		{
+			Result.Centroid.Z += Point.Z / Points.Num();
+		}
+	}
+
+	// The camera looks at the centroid: each side must fit the farthest point from it
+	const FVector2D CentroidGround(Result.Centroid.X, Result.Centroid.Y);
+	const double CentroidRight = FVector2D::DotProduct(Right, CentroidGround);
+	const double CentroidBack = FVector2D::DotProduct(Back, CentroidGround);
+	const double HalfRight = FMath::Max(MaxRight - CentroidRight, CentroidRight - MinRight);
+	const double HalfBack = FMath::Max(MaxBack - CentroidBack, CentroidBack - MinBack);
+
+	Result.HorizontalSpread = static_cast<float>(MaxRight - MinRight);
+	Result.VerticalSpread = static_cast<float>(MaxBack - MinBack);
+
+	//HORIZONTAL
+	const double EdgeDistHor = HalfRight + Settings.HorizontalBuffer;
+	Result.HorizontalArmLength = static_cast<float>(EdgeDistHor / FMath::Tan(FMath::DegreesToRadians(Settings.HorizontalFOV / 2.0)));
+
+	//VERTICAL
+	const double EdgeDistVer = HalfBack + Settings.VerticalBuffer;
+	const double PitchRadians = FMath::DegreesToRadians(-Settings.Pitch);
+	Result.VerticalArmLength = static_cast<float>(FMath::Sin(PitchRadians) * EdgeDistVer / FMath::Tan(FMath::DegreesToRadians(Settings.VerticalFOV / 2.0))
+		+ FMath::Cos(PitchRadians) * EdgeDistVer);
+
+	Result.ArmLength = FMath::Max3(Result.HorizontalArmLength, Result.VerticalArmLength, Settings.MinimumArmLength);
+	return Result;
+}
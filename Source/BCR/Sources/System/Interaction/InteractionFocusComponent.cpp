@@ -0,0 +1,182 @@
+#include "BCR/Headers/System/Interaction/InteractionFocusComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	constexpr EInteractionType SlotTypes[2] = { EInteractionType::Pickable, EInteractionType::Interactable };
+}
+
+static TAutoConsoleVariable<bool> CVarInteractionAsyncTraces(
+	TEXT("Interaction.AsyncTraces"),
+	true,
+	TEXT("Line-of-sight traces of the interaction focus run off the game thread (one frame of latency). 0: synchronous"));
+
+UInteractionFocusComponent::UInteractionFocusComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+float UInteractionFocusComponent::Score(const AActor* Candidate, float CandidateRadius) const
+{
+	const AActor* Owner = GetOwner();
+	const FVector ToCandidate = Candidate->GetActorLocation() - Owner->GetActorLocation();
+
+	// Distance to the bounds, not to the pivot
+	const float Distance = FMath::Max(0.0f, static_cast<float>(ToCandidate.Size()) - CandidateRadius);
+	if (Distance > radius)
+	{
+		return MAX_flt;
+	}
+
+	const float Facing = static_cast<float>(FVector::DotProduct(Owner->GetActorForwardVector().GetSafeNormal2D(), ToCandidate.GetSafeNormal2D()));
+	return Distance / radius + facingWeight * (1.0f - Facing) * 0.5f;
+}
+
+void UInteractionFocusComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const UInteractionIndex* index = UInteractionIndex::Get(this);
+	if (!index)
+	{
+		return;
+	}
+
+	FFocusSlot newFocus[2] = { focus[0], focus[1] };
+
+	// The focus is rescored every frame: it is dropped as soon as it is carried, pooled or out of reach
+	for (FFocusSlot& slot : newFocus)
+	{
+		const AActor* actor = slot.Actor.Get();
+		slot.Score = actor && index->Contains(actor) ? Score(actor, slot.Radius) : MAX_flt;
+		if (slot.Score == MAX_flt)
+		{
+			slot = FFocusSlot();
+		}
+	}
+
+	// New pass: the previous one's winners become the focus, then candidates are gathered again
+	if (cursor >= candidates.Num())
+	{
+		for (int32 i = 0; i < 2; i++)
+		{
+			const AActor* actor = pass[i].Actor.Get();
+			const float score = actor && index->Contains(actor) ? Score(actor, pass[i].Radius) : MAX_flt;
+			newFocus[i] = score < MAX_flt ? FFocusSlot{ pass[i].Actor, score, pass[i].Radius } : FFocusSlot();
+			pass[i] = FFocusSlot();
+		}
+
+		index->GatherCandidates(GetOwner()->GetActorLocation(), radius, EInteractionType::Pickable | EInteractionType::Interactable, GetOwner(), candidates);
+		cursor = 0;
+	}
+
+	// Amortized ranking: a few candidates per frame
+	const int32 end = FMath::Min(cursor + candidatesPerFrame, candidates.Num());
+	for (; cursor < end; cursor++)
+	{
+		const FInteractionCandidate& candidate = candidates[cursor];
+		AActor* actor = candidate.Actor.Get();
+		if (!actor)
+		{
+			continue;
+		}
+
+		const float score = Score(actor, candidate.Radius);
+		for (int32 i = 0; i < 2; i++)
+		{
+			if (!EnumHasAnyFlags(candidate.Type, SlotTypes[i]))
+			{
+				continue;
+			}
+			if (score < pass[i].Score)
+			{
+				pass[i] = { actor, score, candidate.Radius };
+			}
+			// A better candidate takes the focus right away, without waiting for the end of the pass
+			if (score < newFocus[i].Score)
+			{
+				newFocus[i] = { actor, score, candidate.Radius };
+			}
+		}
+	}
+
+	focus[0] = newFocus[0];
+	focus[1] = newFocus[1];
+	PublishFocus(ResolveVisibility(0, focus[0].Actor.Get()), ResolveVisibility(1, focus[1].Actor.Get()));
+}
+
+FCollisionQueryParams UInteractionFocusComponent::MakeTraceParams(const AActor* Target) const
+{
+	// Only what stands between the owner and the target counts: the target itself and carried items are ignored
+	FCollisionQueryParams params(SCENE_QUERY_STAT(InteractionFocusVisibility), false, GetOwner());
+	params.AddIgnoredActor(Target);
+
+	TArray<AActor*> attached;
+	GetOwner()->GetAttachedActors(attached);
+	params.AddIgnoredActors(attached);
+	return params;
+}
+
+AActor* UInteractionFocusComponent::ResolveVisibility(int32 Slot, AActor* Ranked)
+{
+	if (!bRequireLineOfSight)
+	{
+		return Ranked;
+	}
+	if (!Ranked)
+	{
+		// Checked again if it comes back into reach
+		answeredActors[Slot].Reset();
+		return nullptr;
+	}
+
+	UWorld* world = GetWorld();
+	const FVector start = GetOwner()->GetActorLocation();
+	const FVector end = Ranked->GetActorLocation();
+
+	if (!CVarInteractionAsyncTraces.GetValueOnGameThread())
+	{
+		if (answeredActors[Slot] != Ranked)
+		{
+			answeredActors[Slot] = Ranked;
+			bAnsweredVisible[Slot] = !world->LineTraceTestByChannel(start, end, ECC_Visibility, MakeTraceParams(Ranked));
+		}
+		return bAnsweredVisible[Slot] ? Ranked : nullptr;
+	}
+
+	// Answer to the trace requested last frame, always read here so the result does not depend on thread timing
+	if (visibilityTraces[Slot].IsValid())
+	{
+		FTraceDatum datum;
+		if (world->QueryTraceData(visibilityTraces[Slot], datum))
+		{
+			answeredActors[Slot] = tracedActors[Slot];
+			bAnsweredVisible[Slot] = !FHitResult::GetFirstBlockingHit(datum.OutHits);
+		}
+		visibilityTraces[Slot].Invalidate();
+	}
+
+	// One trace per newly ranked actor, not one per frame
+	if (answeredActors[Slot] != Ranked)
+	{
+		visibilityTraces[Slot] = world->AsyncLineTraceByChannel(EAsyncTraceType::Test, start, end, ECC_Visibility, MakeTraceParams(Ranked));
+		tracedActors[Slot] = Ranked;
+	}
+
+	return answeredActors[Slot] == Ranked && bAnsweredVisible[Slot] ? Ranked : nullptr;
+}
+
+void UInteractionFocusComponent::PublishFocus(AActor* Pickable, AActor* Interactable)
+{
+	if (published[0] == Pickable && published[1] == Interactable)
+	{
+		return;
+	}
+
+	published[0] = Pickable;
+	published[1] = Interactable;
+	OnFocusChanged.Broadcast(Pickable, Interactable);
+}
@@ -0,0 +1,262 @@
+#include "BCR/Headers/System/Interaction/InteractionIndex.h"
+#include "BCR/Headers/Interfaces/IPickable.h"
+#include "BCR/Headers/Interfaces/Interactable.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DECLARE_STATS_GROUP(TEXT("Interaction"), STATGROUP_Interaction, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Gather Candidates"), STAT_InteractionGather, STATGROUP_Interaction);
+
+namespace
+{
+	/* About the reach of a player: a query usually touches 4 cells */
+	constexpr float CellSize = 200.0f;
+
+	/* Horizontal reach of the components the former visibility sweep could hit (trigger zones are left out) */
+	float ComputeInteractionRadius(const AActor* Actor)
+	{
+		FBox Bounds(ForceInit);
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&Bounds](const UPrimitiveComponent* Primitive)
+		{
+			if (Primitive->IsRegistered() && Primitive->IsCollisionEnabled() && Primitive->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block)
+			{
+				Bounds += Primitive->Bounds.GetBox();
+			}
+		});
+
+		if (!Bounds.IsValid)
+		{
+			return 0.0f;
+		}
+		return static_cast<float>((Bounds.GetCenter() - Actor->GetActorLocation()).Size2D() + Bounds.GetExtent().Size2D());
+	}
+}
+
+UInteractionIndex* UInteractionIndex::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInteractionIndex>() : nullptr;
+}
+
+void UInteractionIndex::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UInteractionIndex::OnActorSpawned));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UInteractionIndex::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UInteractionIndex::OnLevelRemoved);
+}
+
+void UInteractionIndex::Deinitialize()
+{
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	Entries.Empty();
+	EntryIndices.Empty();
+	Cells.Empty();
+	Super::Deinitialize();
+}
+
+void UInteractionIndex::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Actors placed in the level
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		UpdateActor(*It);
+	}
+}
+
+void UInteractionIndex::OnActorSpawned(AActor* Actor)
+{
+	UpdateActor(Actor);
+}
+
+void UInteractionIndex::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	// Streamed actors are loaded, not spawned
+	if (World != GetWorld() || !Level)
+	{
+		return;
+	}
+	for (AActor* Actor : Level->Actors)
+	{
+		UpdateActor(Actor);
+	}
+}
+
+void UInteractionIndex::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	// A null level means the whole world is going away: Deinitialize clears everything
+	if (World != GetWorld() || !Level)
+	{
+		return;
+	}
+	for (const AActor* Actor : Level->Actors)
+	{
+		Unregister(Actor);
+	}
+}
+
+void UInteractionIndex::OnRootMoved(USceneComponent* Root, EUpdateTransformFlags Flags, ETeleportType Teleport)
+{
+	// Pooled items are moved before being registered again
+	const int32* Existing = EntryIndices.Find(Root->GetOwner());
+	if (!Existing)
+	{
+		return;
+	}
+
+	// Physics moves an item a little each frame: relink only when it leaves its cells
+	FInteractionEntry& Entry = Entries[*Existing];
+	Entry.Location = Root->GetComponentLocation();
+	if (ToCell(Entry.Location - FVector(Entry.Radius)) != Entry.MinCell || ToCell(Entry.Location + FVector(Entry.Radius)) != Entry.MaxCell)
+	{
+		UnlinkCells(*Existing);
+		LinkCells(*Existing);
+	}
+}
+
+void UInteractionIndex::OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	Unregister(Actor);
+}
+
+FIntPoint UInteractionIndex::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UInteractionIndex::UpdateActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	if (const int32* Existing = EntryIndices.Find(Actor))
+	{
+		// Moved: only the cells change
+		UnlinkCells(*Existing);
+		Entries[*Existing].Location = Actor->GetActorLocation();
+		LinkCells(*Existing);
+		return;
+	}
+
+	EInteractionType Type = EInteractionType::None;
+	if (Actor->Implements<UIPickable>())
+	{
+		Type |= EInteractionType::Pickable;
+	}
+	if (Actor->Implements<UInteractable>())
+	{
+		Type |= EInteractionType::Interactable;
+	}
+	if (Type == EInteractionType::None)
+	{
+		return;
+	}
+
+	FInteractionEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Radius = ComputeInteractionRadius(Actor);
+	Entry.Type = Type;
+
+	const int32 EntryIndex = Entries.Add(Entry);
+	EntryIndices.Add(Actor, EntryIndex);
+	LinkCells(EntryIndex);
+
+	Actor->OnEndPlay.AddUniqueDynamic(this, &UInteractionIndex::OnActorEndPlay);
+
+	USceneComponent* Root = Actor->GetRootComponent();
+	if (Root && Root->Mobility == EComponentMobility::Movable)
+	{
+		Root->TransformUpdated.AddUObject(this, &UInteractionIndex::OnRootMoved);
+	}
+}
+
+void UInteractionIndex::Unregister(const AActor* Actor)
+{
+	int32 EntryIndex;
+	if (EntryIndices.RemoveAndCopyValue(Actor, EntryIndex))
+	{
+		if (USceneComponent* Root = Actor->GetRootComponent())
+		{
+			Root->TransformUpdated.RemoveAll(this);
+		}
+		UnlinkCells(EntryIndex);
+		Entries.RemoveAt(EntryIndex);
+	}
+}
+
+void UInteractionIndex::LinkCells(int32 EntryIndex)
+{
+	FInteractionEntry& Entry = Entries[EntryIndex];
+	Entry.MinCell = ToCell(Entry.Location - FVector(Entry.Radius));
+	Entry.MaxCell = ToCell(Entry.Location + FVector(Entry.Radius));
+
+	for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+	{
+		for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(EntryIndex);
+		}
+	}
+}
+
+void UInteractionIndex::UnlinkCells(int32 EntryIndex)
+{
+	const FInteractionEntry& Entry = Entries[EntryIndex];
+	for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+	{
+		for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+		{
+			// Emptied cells are kept: items tend to come back to the same places
+			if (TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y)))
+			{
+				Cell->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+			}
+		}
+	}
+}
+
+void UInteractionIndex::GatherCandidates(const FVector& Origin, float Radius, EInteractionType Types, const AActor* Ignore, TArray<FInteractionCandidate>& OutCandidates) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractionGather);
+
+	OutCandidates.Reset();
+	const FIntPoint MinCell = ToCell(Origin - FVector(Radius));
+	const FIntPoint MaxCell = ToCell(Origin + FVector(Radius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 EntryIndex : *Cell)
+			{
+				const FInteractionEntry& Entry = Entries[EntryIndex];
+
+				// An actor spanning several cells is only reported from the first one the query visits
+				if (X != FMath::Max(MinCell.X, Entry.MinCell.X) || Y != FMath::Max(MinCell.Y, Entry.MinCell.Y))
+				{
+					continue;
+				}
+
+				if (EnumHasAnyFlags(Entry.Type, Types) && Entry.Actor.Get() != Ignore)
+				{
+					OutCandidates.Add({ Entry.Actor, Entry.Type, Entry.Radius });
+				}
+			}
+		}
+	}
+}
@@ -1,12 +1,13 @@
 #include "BCR/Headers/System/MainCamera.h"
 #include "Kismet/KismetMathLibrary.h"
 #include <Kismet/GameplayStatics.h>
+#include "Engine/World.h"
 
 // Sets default values
 AMainCamera::AMainCamera()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Updated by AMainCameraManager after every actor has ticked
+	PrimaryActorTick.bCanEverTick = false;
 
 	DefaultRootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultRootComponent"));
 	SetRootComponent(DefaultRootComponent);
@@ -14,6 +15,8 @@ AMainCamera::AMainCamera()
 	// Create a camera boom (pulls in towards the player if there is a collision)
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
+	// The arm is only read to build the view: no per-frame transform update of the hierarchy
+	CameraBoom->PrimaryComponentTick.bCanEverTick = false;
 
 	// Create a follow camera
 	FollowCamera = CreateDefaultSubobject<UCineCameraComponent>(TEXT("FollowCamera"));
@@ -32,24 +35,126 @@ void AMainCamera::BeginPlay()
 	InitParam();
 }
 
-// Called every frame
-void AMainCamera::Tick(float DeltaTime)
+void AMainCamera::ComputeView(float DeltaTime, FMinimalViewInfo& OutPOV)
 {
-	Super::Tick(DeltaTime);
-
-	if (!Players[0] || !Players[1])
+	if (LastViewFrame == GFrameCounter)
 	{
+		OutPOV = LastView;
 		return;
 	}
+	LastViewFrame = GFrameCounter;
+
+	UpdateFraming();
+	if (!FramingPoints.IsEmpty())
+	{
+		UpdatePosition(DeltaTime);
+		UpdateArmLenght(DeltaTime);
+		UpdateArmAngle(DeltaTime);
+	}
 
-	UpdatePosition();
-	UpdateArmLenght();
-	UpdateArmAngle();
+	// Placement computed like the spring arm would, collision probe included
+	const FQuat PivotRotation = GetViewRotation().Quaternion();
+	const FQuat ArmRotation = PivotRotation * CameraBoom->GetRelativeRotation().Quaternion();
+	const FVector ArmOrigin = ViewPivot + PivotRotation.RotateVector(CameraBoom->GetRelativeLocation()) + CameraBoom->TargetOffset;
+	const FVector ArmEnd = ProbeArm(ArmOrigin, ArmOrigin + ArmRotation.RotateVector(FVector(-ViewArmLength, 0.f, 0.f) + CameraBoom->SocketOffset));
+	const FVector CameraLocation = ArmEnd + ArmRotation.RotateVector(FollowCamera->GetRelativeLocation());
+
+	// Lens, aperture and post process from the cine camera, focused on the pivot wherever the probe put the camera
+	FollowCamera->FocusSettings.ManualFocusDistance = static_cast<float>((CameraLocation - ViewPivot).Size());
+	FollowCamera->GetCameraView(DeltaTime, OutPOV);
+
+	OutPOV.Location = CameraLocation;
+	OutPOV.Rotation = (ArmRotation * FollowCamera->GetRelativeRotation().Quaternion()).Rotator();
+
+	if (DebugLocation)
+	{
+		DebugSphere->SetWorldLocation(ViewPivot);
+	}
+
+	LastView = OutPOV;
+}
+
+FVector AMainCamera::ProbeArm(const FVector& ArmOrigin, const FVector& DesiredEnd) const
+{
+	if (!CameraBoom->bDoCollisionTest || CameraBoom->ProbeSize <= 0.f)
+	{
+		return DesiredEnd;
+	}
+
+	// Same query as USpringArmComponent::UpdateDesiredArmLocation (no lag: the springs already smooth the view)
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SpringArm), false, this);
+	FHitResult Hit;
+	GetWorld()->SweepSingleByChannel(Hit, ArmOrigin, DesiredEnd, FQuat::Identity, CameraBoom->ProbeChannel, FCollisionShape::MakeSphere(CameraBoom->ProbeSize), QueryParams);
+	return Hit.bBlockingHit ? Hit.Location : DesiredEnd;
 }
 
 void AMainCamera::SetPlayers(ACharacter* Player1, ACharacter* Player2)
 {
-	Players = { Player1, Player2 };
+	SetPlayerList({ Player1, Player2 });
+}
+
+void AMainCamera::SetPlayerList(const TArray<ACharacter*>& NewPlayers)
+{
+	Players.Reset(NewPlayers.Num());
+	for (ACharacter* player : NewPlayers)
+	{
+		if (player)
+		{
+			Players.Add(player);
+		}
+	}
+}
+
+void AMainCamera::AddFramingTarget(AActor* Target, float Weight)
+{
+	RemoveFramingTarget(Target);
+	if (Target)
+	{
+		FramingTargets.Emplace(Target, FMath::Max(0.f, Weight));
+	}
+}
+
+void AMainCamera::RemoveFramingTarget(AActor* Target)
+{
+	FramingTargets.RemoveAll([Target](const TPair<TWeakObjectPtr<AActor>, float>& Entry) { return Entry.Key.Get() == Target; });
+}
+
+void AMainCamera::UpdateFraming()
+{
+	FramingPoints.Reset();
+	for (const ACharacter* player : Players)
+	{
+		if (IsValid(player))
+		{
+			FramingPoints.Emplace(player->GetActorLocation(), 1.f);
+		}
+	}
+	for (const TPair<TWeakObjectPtr<AActor>, float>& target : FramingTargets)
+	{
+		if (const AActor* actor = target.Key.Get())
+		{
+			FramingPoints.Emplace(actor->GetActorLocation(), target.Value);
+		}
+	}
+
+	if (FramingPoints.IsEmpty())
+	{
+		return;
+	}
+
+	FCameraFramingSettings Settings;
+	const FRotator ViewRotation = GetViewRotation();
+	const FVector RightVector = FRotationMatrix(ViewRotation).GetUnitAxis(EAxis::Y);
+	Settings.RightAxis = RightVector;
+	Settings.BackAxis = UKismetMathLibrary::RotateAngleAxis(-ViewRotation.Vector(), ViewPitch, RightVector);
+	Settings.Pitch = ViewPitch;
+	Settings.HorizontalFOV = FollowCamera->GetHorizontalFieldOfView();
+	Settings.VerticalFOV = FollowCamera->GetVerticalFieldOfView();
+	Settings.HorizontalBuffer = HorizontalBuffer;
+	Settings.VerticalBuffer = VerticalBuffer;
+	Settings.MinimumArmLength = MinimumArmLength;
+
+	Framing = FCameraFraming::Solve(FramingPoints, Settings);
 }
 
 void AMainCamera::InitParam()
@@ -57,33 +162,31 @@ void AMainCamera::InitParam()
 	CameraBaseHeight = GetActorLocation().Z;
 	DebugSphere->SetHiddenInGame(!DebugLocation);
 
-	FollowCamera->FocusSettings.TrackingFocusSettings.ActorToTrack = this;
+	ViewPivot = GetActorLocation();
+	ViewPitch = GetActorRotation().Pitch;
+	ViewYaw = GetActorRotation().Yaw;
+	ViewArmLength = CameraBoom->TargetArmLength;
+
+	// The actor no longer follows the players: focus on the framed pivot (distance updated with the view)
+	FollowCamera->FocusSettings.FocusMethod = ECameraFocusMethod::Manual;
+	FollowCamera->FocusSettings.ManualFocusDistance = ViewArmLength;
 	FollowCamera->LensSettings.MinFStop = MinFStop;
 	FollowCamera->LensSettings.MaxFStop = MaxFStop;
 }
 
-void AMainCamera::UpdatePosition()
+void AMainCamera::UpdatePosition(float DeltaTime)
 {
-	FVector AveragePosition;
-	for (ACharacter* player : Players)
-	{
-		if (!player)
-		{
-			return;
-		}
-		AveragePosition += player->GetActorLocation();
-	}
-	AveragePosition = AveragePosition / Players.Num();
+	FVector AveragePosition = Framing.Centroid;
 
 	if (!EnableVerticalMovement)
 	{
 		AveragePosition.Z = CameraBaseHeight;
 	}
 
-	SetActorLocation(AveragePosition);
+	ViewPivot = PositionSpring.Update(AveragePosition, PositionSmoothTime, DeltaTime, MaxSubstepTime);
 }
 
-void AMainCamera::UpdateArmLenght()
+void AMainCamera::UpdateArmLenght(float DeltaTime)
 {
 	/** TESTS
 	float PlayerDist = (Players[0]->GetActorLocation() - Players[1]->GetActorLocation()).Size();
@@ -104,66 +207,50 @@ void AMainCamera::UpdateArmLenght()
 	}
 	*/
 
-	FVector PlayerDistVec = Players[0]->GetActorLocation() - Players[1]->GetActorLocation();
-
-	//HORIZONTAL
-	float PlayerDistHor = FMath::Abs(UKismetMathLibrary::DotProduct2D(Get2DVect(GetActorRightVector()).GetSafeNormal(), Get2DVect(PlayerDistVec)));
-	float EdgeDistHor = (PlayerDistHor / 2) + HorizontalBuffer;
-	float TanDemiAngleHor = UKismetMathLibrary::DegTan(FollowCamera->GetHorizontalFieldOfView() / 2);
-
-	float TotalArmLengthHor = EdgeDistHor / TanDemiAngleHor;
-
-	//VERTICAL
-	FVector BackVector = UKismetMathLibrary::RotateAngleAxis(-GetActorForwardVector(), GetActorRotation().Pitch, GetActorRightVector());
-	float PlayerDistVer = FMath::Abs(UKismetMathLibrary::DotProduct2D(Get2DVect(BackVector).GetSafeNormal(), Get2DVect(PlayerDistVec)));
-	float EdgeDistVer = (PlayerDistVer / 2) + VerticalBuffer;
-	float TanDemiAngleVer = UKismetMathLibrary::DegTan(FollowCamera->GetVerticalFieldOfView() / 2);
-
-	float TotalArmLengthVer = (UKismetMathLibrary::DegSin(-GetActorRotation().Pitch) * EdgeDistVer / TanDemiAngleVer) +
-		(UKismetMathLibrary::DegCos(-GetActorRotation().Pitch) * EdgeDistVer);
-
-	CameraBoom->TargetArmLength = FMath::Max3(TotalArmLengthHor, TotalArmLengthVer, MinimumArmLength);
+	ViewArmLength = ArmLengthSpring.Update(Framing.ArmLength, ArmLengthSmoothTime, DeltaTime, MaxSubstepTime);
+	CameraBoom->TargetArmLength = ViewArmLength;
 
-	UpdateBlur(PlayerDistVer);
+	UpdateBlur(Framing.VerticalSpread, DeltaTime);
 
 	if (DebugVariables)
 	{
 		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Horizontal FOV = %f"), FollowCamera->GetHorizontalFieldOfView()));
 		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Vertical FOV = %f"), FollowCamera->GetVerticalFieldOfView()));
 
-		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Player distance vertical = %f"), PlayerDistVer));
-		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Player distance horizontal = %f"), PlayerDistHor));
-		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Player distance = %f"), PlayerDistVec.Size()));
+		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Player distance vertical = %f"), Framing.VerticalSpread));
+		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Player distance horizontal = %f"), Framing.HorizontalSpread));
+		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Framed points = %d"), FramingPoints.Num()));
 		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Spring arm length offset = %f"), CameraBoom->TargetArmLength - MinimumArmLength));
 
 		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("DISTANCE VARIABLES")));
 	}
 }
 
-void AMainCamera::UpdateArmAngle()
+void AMainCamera::UpdateArmAngle(float DeltaTime)
 {
 	if (!UseAngleChange)
 	{
 		return;
 	}
 
-	float Alpha = (CameraBoom->TargetArmLength - MinAngleReachedAtArmLength) / (MaxAngleReachedAtArmLength - MinAngleReachedAtArmLength);
+	float Alpha = (ViewArmLength - MinAngleReachedAtArmLength) / (MaxAngleReachedAtArmLength - MinAngleReachedAtArmLength);
 	Alpha = FMath::Clamp(Alpha, 0.f, 1.f);
-	SetActorRotation({ -FMath::InterpEaseInOut(MinArmAngle, MaxArmAngle, Alpha, EasingAngleExp), 0.f, 0.f});
+	const float TargetPitch = -FMath::InterpEaseInOut(MinArmAngle, MaxArmAngle, Alpha, EasingAngleExp);
+	ViewPitch = PitchSpring.Update(TargetPitch, PitchSmoothTime, DeltaTime, MaxSubstepTime);
 
 	if (DebugVariables)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Camera angle = %f"), GetActorRotation().Pitch));
+		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("Camera angle = %f"), ViewPitch));
 
 		GEngine->AddOnScreenDebugMessage(-1, 0.f, FColor::Orange, FString::Printf(TEXT("ANGLE VARIABLES")));
 	}
 }
 
-void AMainCamera::UpdateBlur(float VerticalPlayerDistance)
+void AMainCamera::UpdateBlur(float VerticalPlayerDistance, float DeltaTime)
 {
 	float FStopAlpha = GetAlpha(VerticalPlayerDistance, MaxBlurAtDistance, MinBlurAtDistance);
 	float Aperture = GetValue(FStopAlpha, MinFStop, MaxFStop);
-	FollowCamera->CurrentAperture = Aperture / BlurMultiplier;
+	FollowCamera->CurrentAperture = ApertureSpring.Update(Aperture / BlurMultiplier, ApertureSmoothTime, DeltaTime, MaxSubstepTime);
 }
 
 FVector2D AMainCamera::Get2DVect(FVector vect3d)
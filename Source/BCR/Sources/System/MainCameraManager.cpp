@@ -0,0 +1,34 @@
+#include "BCR/Headers/System/MainCameraManager.h"
+#include "BCR/Headers/System/MainCamera.h"
+
+void AMainCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+{
+	AMainCamera* MainCamera = Cast<AMainCamera>(OutVT.Target);
+	if (!MainCamera)
+	{
+		Super::UpdateViewTarget(OutVT, DeltaTime);
+		return;
+	}
+
+	// The outgoing target of a locked blend keeps its last view
+	if (PendingViewTarget.Target && BlendParams.bLockOutgoing && OutVT.Equal(ViewTarget))
+	{
+		return;
+	}
+
+	// Same starting point as the base class: manager defaults, then whatever the cine camera sets
+	OutVT.POV = FMinimalViewInfo();
+	OutVT.POV.FOV = DefaultFOV;
+	OutVT.POV.OrthoWidth = DefaultOrthoWidth;
+	OutVT.POV.AspectRatio = DefaultAspectRatio;
+	OutVT.POV.bConstrainAspectRatio = bDefaultConstrainAspectRatio;
+	OutVT.POV.ProjectionMode = bIsOrthographic ? ECameraProjectionMode::Orthographic : ECameraProjectionMode::Perspective;
+	OutVT.POV.PostProcessBlendWeight = 1.0f;
+
+	MainCamera->ComputeView(DeltaTime, OutVT.POV);
+
+	// Shakes and other modifiers still apply on top of the framing
+	ApplyCameraModifiers(DeltaTime, OutVT.POV);
+	SetActorLocationAndRotation(OutVT.POV.Location, OutVT.POV.Rotation, false);
+	UpdateCameraLensEffects(OutVT);
+}
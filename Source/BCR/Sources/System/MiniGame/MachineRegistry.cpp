@@ -0,0 +1,60 @@
+#include "BCR/Headers/System/MiniGame/MachineRegistry.h"
+#include "BCR/Headers/System/MiniGame/MiniGameSystem.h"
+#include "Engine/World.h"
+
+UMachineRegistry* UMachineRegistry::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UMachineRegistry>() : nullptr;
+}
+
+void UMachineRegistry::Deinitialize()
+{
+	MachinesByType.Empty();
+	Super::Deinitialize();
+}
+
+void UMachineRegistry::Register(AMiniGameSystem* Machine, TConstArrayView<FItemTypeId> InputTypes)
+{
+	for (const FItemTypeId Type : InputTypes)
+	{
+		if (!Type.IsValid())
+		{
+			continue;
+		}
+		if (Type.GetIndex() >= MachinesByType.Num())
+		{
+			MachinesByType.SetNum(Type.GetIndex() + 1);
+		}
+		// A recipe taking the same item twice lists the machine once
+		MachinesByType[Type.GetIndex()].AddUnique(Machine);
+	}
+}
+
+void UMachineRegistry::Unregister(const AMiniGameSystem* Machine, TConstArrayView<FItemTypeId> InputTypes)
+{
+	for (const FItemTypeId Type : InputTypes)
+	{
+		if (MachinesByType.IsValidIndex(Type.GetIndex()))
+		{
+			MachinesByType[Type.GetIndex()].RemoveSingleSwap(Machine, EAllowShrinking::No);
+		}
+	}
+}
+
+void UMachineRegistry::NotifyItemPickedUp(const APickableItem* Item) const
+{
+	const FItemTypeId Type = Item->GetItemTypeId();
+	if (!MachinesByType.IsValidIndex(Type.GetIndex()))
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AMiniGameSystem>& Machine : MachinesByType[Type.GetIndex()])
+	{
+		if (AMiniGameSystem* MachinePtr = Machine.Get())
+		{
+			MachinePtr->OnItemPickedUp(Item);
+		}
+	}
+}
@@ -3,109 +3,314 @@
 #include "BCR/Headers/System/QTE/QTE_Subsystem.h"
 #include <BCR/Headers/Interfaces/BCR_Helper.h>
 #include <Components/BillboardComponent.h>
+#include <Engine/CollisionProfile.h>
 #include <Kismet/KismetMathLibrary.h>
 #include <Kismet/KismetSystemLibrary.h>
-#include "BCR/Headers/System/QTE/QTE_Subsystem.h"
+#include "BCR/Headers/System/Pickable/ItemTypeRegistry.h"
+#include "BCR/Headers/System/MiniGame/MachineRegistry.h"
+#include "BCR/Headers/System/Pickable/PickablePool.h"
+#include "BCR/Headers/System/Production/ProductionScheduler.h"
 #include "BCR/Headers/Player/MainPlayer.h"
 
+namespace
+{
+	const FName SnapPointTag = TEXT("SnapPoint");
+	constexpr int32 DefaultSnapPointCount = 2;
+	constexpr float DefaultPreloadRadius = 1000.0f;
+
+	void ResolveItemTypes(const UObject* WorldContext, const TArray<TSubclassOf<APickableItem>>& Items, TArray<FItemTypeId>& OutTypes)
+	{
+		OutTypes.Reset();
+		if (UItemTypeRegistry* registry = UItemTypeRegistry::Get(WorldContext))
+		{
+			for (const TSubclassOf<APickableItem>& item : Items)
+			{
+				OutTypes.Add(registry->Resolve(item));
+			}
+		}
+	}
+}
+
 AMiniGameSystem::AMiniGameSystem()
 {
 	DefaultRootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultRootComponent"));
 	SetRootComponent(DefaultRootComponent);
 
-	snapPlayerPoint1 = CreateDefaultSubobject<UBillboardComponent>(TEXT("Snap Point Player 1"));
-	snapPlayerPoint2 = CreateDefaultSubobject<UBillboardComponent>(TEXT("Snap Point Player 2"));
-	outputSpawnPoint = CreateDefaultSubobject<UBillboardComponent>(TEXT("OutPut Spawn Point"));
+	for (int32 i = 0; i < DefaultSnapPointCount; i++)
+	{
+		UBillboardComponent* snapPoint = CreateDefaultSubobject<UBillboardComponent>(*FString::Printf(TEXT("Snap Point Player %d"), i + 1));
+		snapPoint->SetupAttachment(RootComponent);
+		snapPoint->ComponentTags.Add(SnapPointTag);
+		snapPoints.Add(snapPoint);
+	}
 
-	snapPlayerPoint1->SetupAttachment(RootComponent);
-	snapPlayerPoint2->SetupAttachment(RootComponent);
+	outputSpawnPoint = CreateDefaultSubobject<UBillboardComponent>(TEXT("OutPut Spawn Point"));
 	outputSpawnPoint->SetupAttachment(RootComponent);
 
 	inputBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Input Box"));
 
 	inputBox->SetupAttachment(RootComponent);
 
-	PrimaryActorTick.bCanEverTick = true;
+	preloadZone = CreateDefaultSubobject<USphereComponent>(TEXT("Preload Zone"));
+	preloadZone->SetupAttachment(RootComponent);
+	preloadZone->SetSphereRadius(DefaultPreloadRadius);
+	preloadZone->SetCollisionProfileName(UCollisionProfile::CustomCollisionProfileName);
+	preloadZone->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	preloadZone->SetCollisionResponseToAllChannels(ECR_Ignore);
+	preloadZone->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+
+	// Driven by events only: an idle machine costs nothing per frame
+	PrimaryActorTick.bCanEverTick = false;
 }
 
-void AMiniGameSystem::OnFirstSnapPointResult(bool bSuccess)
+void AMiniGameSystem::OnQTESessionComplete(FQTESessionHandle Session, bool bSuccess)
+{
+	// A session abandoned by Reset must not produce anything
+	if (state != EMachineState::RunningQTE || Session != QTESession)
+	{
+		return;
+	}
+	QTESession.Invalidate();
+	FinishExecute(bSuccess);
+}
+
+void AMiniGameSystem::OnSnapPointResult(FQTESessionHandle Session, ESnapPointType SnapPoint, bool bSuccess)
 {
 	// technical log
-	IBCR_Helper::LogConsole(this, FString::Printf(TEXT("Player 1 action: %s"), bSuccess ? TEXT("Success") : TEXT("Failed")));
+	IBCR_Helper::LogConsole(this, FString::Printf(TEXT("Player %d action: %s"), static_cast<int32>(SnapPoint) + 1, bSuccess ? TEXT("Success") : TEXT("Failed")));
 }
 
-void AMiniGameSystem::OnSecondSnapPointResult(bool bSuccess)
+void AMiniGameSystem::PreloadQTE()
+{
+	if (QTEPreload.IsValid() || QTEConfig.IsNull())
+	{
+		return;
+	}
+
+	if (UGameInstance* GameInstance = GetGameInstance())
+	{
+		if (UQTE_Subsystem* QTESystem = GameInstance->GetSubsystem<UQTE_Subsystem>())
+		{
+			QTEPreload = QTESystem->PreloadConfiguration(QTEConfig, FSimpleDelegate::CreateUObject(this, &AMiniGameSystem::OnQTEPreloaded));
+		}
+	}
+}
+
+void AMiniGameSystem::OnQTEPreloaded()
 {
 	// technical log
-	IBCR_Helper::LogConsole(this, FString::Printf(TEXT("Player 2 action: %s"), bSuccess ? TEXT("Success") : TEXT("Failed")));
+	if (QTEPreload.IsValid())
+	{
+		IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE preloaded in %.1f ms"), QTEPreload->LoadDuration * 1000.0));
+	}
+
+	// A missing or broken asset still completes the request: drop it instead of waiting for it forever
+	if (!QTEConfig.Get())
+	{
+		IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE configuration %s could not be loaded"), *QTEConfig.ToString()));
+		bStartWhenLoaded = false;
+		QTEPreload.Reset();
+		return;
+	}
+
+	if (bStartWhenLoaded)
+	{
+		bStartWhenLoaded = false;
+		StartExecute();
+	}
+}
+
+void AMiniGameSystem::OnItemPickedUp(const APickableItem* Item)
+{
+	if (NeedsItem(Item->GetItemTypeId()))
+	{
+		PreloadQTE();
+	}
+}
+
+TSubclassOf<APickableItem> AMiniGameSystem::GetCraftableItem() const
+{
+	const URecipeSubsystem* recipes = URecipeSubsystem::Get(this);
+	const FRecipe* recipe = recipes ? recipes->FindRecipe(loadedItems, loadedItemTypes) : nullptr;
+	return recipe ? recipes->GetResultClass(*recipe) : nullptr;
+}
+
+bool AMiniGameSystem::NeedsItem(FItemTypeId _type) const
+{
+	return missingItems.IsValidIndex(_type.GetIndex()) && missingItems[_type.GetIndex()] > 0;
+}
+
+void AMiniGameSystem::OnPreloadZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (Cast<AMainPlayer>(OtherActor))
+	{
+		PreloadQTE();
+	}
+}
+
+void AMiniGameSystem::OnPreloadZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (!Cast<AMainPlayer>(OtherActor) || bStartWhenLoaded)
+	{
+		return;
+	}
+
+	// Release the preloaded assets once every player has left and no QTE is running
+	TArray<AActor*> players;
+	preloadZone->GetOverlappingActors(players, AMainPlayer::StaticClass());
+	players.Remove(OtherActor);
+
+	if (players.IsEmpty() && state != EMachineState::RunningQTE)
+	{
+		QTEPreload.Reset();
+	}
 }
 
 // Called when the game starts or when spawned
 void AMiniGameSystem::BeginPlay()
 {
-	snapPointMap.Add(snapPlayerPoint1,nullptr);
-	snapPointMap.Add(snapPlayerPoint2, nullptr);
-	
-	itemList = inputItems;
+	// Collect extra snap points added in the blueprint, in a stable order
+	TArray<UBillboardComponent*> taggedPoints;
+	GetComponents<UBillboardComponent>(taggedPoints);
+	taggedPoints.Sort([](const UBillboardComponent& A, const UBillboardComponent& B) { return A.GetName() < B.GetName(); });
+
+	for (UBillboardComponent* point : taggedPoints)
+	{
+		if (point->ComponentHasTag(SnapPointTag))
+		{
+			snapPoints.AddUnique(point);
+		}
+	}
+	snapPoints.Remove(nullptr);
+
+	if (snapPoints.Num() > QTESnapPointTypeCount)
+	{
+		// technical log
+		IBCR_Helper::LogConsole(this, FString::Printf(TEXT("Only %d snap points can join a QTE"), QTESnapPointTypeCount));
+	}
+
+	snapPlayers.Init(nullptr, snapPoints.Num());
+
+	preloadZone->OnComponentBeginOverlap.AddDynamic(this, &AMiniGameSystem::OnPreloadZoneBeginOverlap);
+	preloadZone->OnComponentEndOverlap.AddDynamic(this, &AMiniGameSystem::OnPreloadZoneEndOverlap);
+
+	ResolveItemTypes(this, inputItems, inputItemTypes);
+	ResolveItemTypes(this, outputItems, outputItemTypes);
+	if (UMachineRegistry* machines = UMachineRegistry::Get(this))
+	{
+		machines->Register(this, inputItemTypes);
+	}
+	Reset();
+
+	// One of each output ready before the first production
+	if (UPickablePoolSubsystem* pool = UPickablePoolSubsystem::Get(this))
+	{
+		for (const TSubclassOf<APickableItem>& item : outputItems)
+		{
+			pool->Prewarm(item, 1);
+		}
+	}
 	Super::BeginPlay();
 }
 
-void AMiniGameSystem::Tick(float DeltaTime)
+void AMiniGameSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	// The session would outlive the machine
+	StopQTESession();
+
+	if (UProductionScheduler* scheduler = UProductionScheduler::Get(this))
+	{
+		scheduler->Cancel(this);
+	}
+	if (UMachineRegistry* machines = UMachineRegistry::Get(this))
+	{
+		machines->Unregister(this, inputItemTypes);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void AMiniGameSystem::SetInputItem(TArray<TSubclassOf<APickableItem>> _items)
 {
+	UMachineRegistry* machines = UMachineRegistry::Get(this);
+	if (machines)
+	{
+		machines->Unregister(this, inputItemTypes);
+	}
+
 	inputItems = _items;
-	itemList = _items;
+	ResolveItemTypes(this, inputItems, inputItemTypes);
+	if (machines && HasActorBegunPlay())
+	{
+		machines->Register(this, inputItemTypes);
+	}
+	Reset();
 }
 
 void AMiniGameSystem::SetQTE(UQTEConfigurationAsset* _datas)
 {
 	QTEConfig = _datas;
+	QTEPreload.Reset();
 }
 
 void AMiniGameSystem::SetOutputItem(TArray<TSubclassOf<APickableItem>> _items)
 {
 	outputItems = _items;
+	ResolveItemTypes(this, outputItems, outputItemTypes);
 }
 
 void AMiniGameSystem::StartExecute()
 {
-	if (itemList.IsEmpty())
+	if (state == EMachineState::Producing || state == EMachineState::Cooldown)
 	{
-		if (!QTEConfig)
+		// technical log
+		IBCR_Helper::LogConsole(this, "Machine busy");
+		return;
+	}
+
+	if (state == EMachineState::Ready || state == EMachineState::RunningQTE)
+	{
+		if (QTEConfig.IsNull())
 		{
 			// technical log
 			IBCR_Helper::LogConsole(this, "No QTE Configuration assigned!");
 			return;
 		}
 
+		// The preloader already gave up on this asset (request answered synchronously, see OnQTEPreloaded)
+		if (!QTEConfig.Get() && QTEPreload.IsValid() && QTEPreload->bIsLoaded)
+		{
+			IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE configuration %s could not be loaded"), *QTEConfig.ToString()));
+			QTEPreload.Reset();
+			return;
+		}
+
+		// Never load on the game thread: start as soon as the preloader is done
+		if (!QTEConfig.Get() || (QTEPreload.IsValid() && !QTEPreload->bIsLoaded))
+		{
+			bStartWhenLoaded = true;
+			PreloadQTE();
+			return;
+		}
+
 		if (UGameInstance* GameInstance = GetGameInstance())
 		{
 			if (UQTE_Subsystem* QTESystem = GameInstance->GetSubsystem<UQTE_Subsystem>())
 			{
-				if (QTESystem->GetCurrentState() != EQTEState::Running && QTESystem->GetCurrentState() != EQTEState::WaitingForPlayers)
+				if (state != EMachineState::RunningQTE)
 				{
 					// technical log
 					IBCR_Helper::LogConsole(this, "Setting up QTE");
-					
-					// Binding callbacks
-					QTESystem->OnQTEComplete.AddDynamic(this, &AMiniGameSystem::FinishExecute);
-					QTESystem->OnSnapPointFirstResult.AddDynamic(this, &AMiniGameSystem::OnFirstSnapPointResult);
-					QTESystem->OnSnapPointSecondResult.AddDynamic(this, &AMiniGameSystem::OnSecondSnapPointResult);
 
 					CallQTEReader();
 				}
 				
-				if (snapPointMap[snapPlayerPoint1])
+				const int32 numSlots = FMath::Min(snapPlayers.Num(), QTESnapPointTypeCount);
+				for (int32 i = 0; i < numSlots; i++)
 				{
-					QTESystem->OnPlayerEnterSnapPoint(snapPointMap[snapPlayerPoint1], ESnapPointType::First);
-				}
-				if (snapPointMap[snapPlayerPoint2])
-				{
-					QTESystem->OnPlayerEnterSnapPoint(snapPointMap[snapPlayerPoint2], ESnapPointType::Second);
+					if (snapPlayers[i])
+					{
+						QTESystem->OnPlayerEnterSnapPoint(QTESession, snapPlayers[i], static_cast<ESnapPointType>(i));
+					}
 				}
 			}
 		}
@@ -126,23 +331,38 @@ void AMiniGameSystem::CallQTEReader()
 	{
 		if (UQTE_Subsystem* QTESystem = GameInstance->GetSubsystem<UQTE_Subsystem>())
 		{
-			QTESystem->StartQTEFromAsset(QTEConfig);
+			QTESession = QTESystem->StartQTEFromAsset(QTEConfig.Get());
+
+			// Binding callbacks (session delegates die with the session)
+			if (FQTESessionDelegates* Delegates = QTESystem->GetSessionDelegates(QTESession))
+			{
+				Delegates->OnComplete.AddUObject(this, &AMiniGameSystem::OnQTESessionComplete);
+				Delegates->OnSnapPointResult.AddUObject(this, &AMiniGameSystem::OnSnapPointResult);
+				SetState(EMachineState::RunningQTE);
+			}
 		}
 	}
 }
 
-void AMiniGameSystem::FinishExecute(bool _success)
+void AMiniGameSystem::StopQTESession()
 {
-	if (UGameInstance* GameInstance = GetGameInstance())
+	// Unbind first so stopping the session does not run FinishExecute
+	UGameInstance* GameInstance = GetGameInstance();
+	UQTE_Subsystem* QTESystem = GameInstance ? GameInstance->GetSubsystem<UQTE_Subsystem>() : nullptr;
+	if (QTESystem && QTESession.IsValid())
 	{
-		if (UQTE_Subsystem* QTESystem = GameInstance->GetSubsystem<UQTE_Subsystem>())
+		if (FQTESessionDelegates* Delegates = QTESystem->GetSessionDelegates(QTESession))
 		{
-			QTESystem->OnQTEComplete.RemoveDynamic(this, &AMiniGameSystem::FinishExecute);
-			QTESystem->OnSnapPointFirstResult.RemoveDynamic(this, &AMiniGameSystem::OnFirstSnapPointResult);
-			QTESystem->OnSnapPointSecondResult.RemoveDynamic(this, &AMiniGameSystem::OnSecondSnapPointResult);
+			Delegates->OnComplete.RemoveAll(this);
+			Delegates->OnSnapPointResult.RemoveAll(this);
 		}
+		QTESystem->StopQTE(QTESession);
 	}
+	QTESession.Invalidate();
+}
 
+void AMiniGameSystem::FinishExecute(bool _success)
+{
 	// technical log
 	IBCR_Helper::LogConsole(this, 
 		FString::Printf(TEXT("QTE Execution finished with result: %s"), 
@@ -156,7 +376,8 @@ void AMiniGameSystem::FinishExecute(bool _success)
 			GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("Machine active!"));
 		}
 		
-		SpawnItem(0);
+		SetState(EMachineState::Producing);
+		StartProduction();
 	}
 	else
 	{
@@ -165,7 +386,7 @@ void AMiniGameSystem::FinishExecute(bool _success)
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("Machine failed!"));
 		}
-		Reset();
+		EnterCooldown();
 	}
 }
 
@@ -179,59 +400,123 @@ void AMiniGameSystem::SpawnItem(int i)
 			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, TEXT("Production complete"));
 		}
 		
-		Reset();
+		EnterCooldown();
 		return;
 	}
 	
-	FTimerHandle TimerHandle;
-	FTimerDelegate TimerDelegate = FTimerDelegate::CreateUObject(this, &AMiniGameSystem::SpawnItem, i + 1);
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle, TimerDelegate, 3, false);
-
 	// technical log
-	IBCR_Helper::LogConsole(this, FString::Printf(TEXT("Spawning item: %s"), *outputItems[i].GetDefaultObject()->GetItemName()));
+	if (UItemTypeRegistry* registry = UItemTypeRegistry::Get(this); registry && outputItemTypes.IsValidIndex(i))
+	{
+		IBCR_Helper::LogConsole(this, FString::Printf(TEXT("Spawning item: %s"), *registry->GetDisplayName(outputItemTypes[i])));
+	}
 
-	FRotator Rotation(0.0f, 0.0f, 0.0f);
-	FActorSpawnParameters SpawnInfo;
-	GetWorld()->SpawnActor<APickableItem>(outputItems[i], outputSpawnPoint->GetComponentLocation(), GetActorRotation());
+	if (UPickablePoolSubsystem* pool = UPickablePoolSubsystem::Get(this))
+	{
+		pool->Acquire(outputItems[i], FTransform(GetActorRotation(), outputSpawnPoint->GetComponentLocation()));
+	}
 }
 
-void AMiniGameSystem::Reset()
+void AMiniGameSystem::StartProduction()
 {
-	itemList = inputItems;
+	UProductionScheduler* scheduler = UProductionScheduler::Get(this);
+	if (!scheduler)
+	{
+		return;
+	}
+
+	// Recipe time when the loaded items match a recipe, machine default otherwise
+	const URecipeSubsystem* recipes = URecipeSubsystem::Get(this);
+	const FRecipe* recipe = recipes ? recipes->FindRecipe(loadedItems, loadedItemTypes) : nullptr;
+	const double interval = recipe && recipe->ProductionTime > 0.0f ? recipe->ProductionTime : productionTime;
+
+	// First output right away, then one per interval; the extra job ends the run
+	for (int32 i = 0; i <= outputItems.Num(); i++)
+	{
+		scheduler->Schedule(this, i, i * interval);
+	}
 }
 
-void AMiniGameSystem::Interact_Implementation(AMainPlayer* Player)
+void AMiniGameSystem::SetState(EMachineState _state)
 {
-	if (snapPointMap.Find(snapPlayerPoint1)[0] == Player)
+	if (state == _state)
 	{
-		snapPointMap.Add(snapPlayerPoint1, nullptr);
-		//set state machine to liberate the player
 		return;
 	}
-	if (snapPointMap.Find(snapPlayerPoint2)[0] == Player)
+
+	const EMachineState oldState = state;
+	state = _state;
+	OnStateChanged.Broadcast(oldState, state);
+}
+
+void AMiniGameSystem::EnterCooldown()
+{
+	SetState(EMachineState::Cooldown);
+
+	if (cooldownTime > 0.0f)
 	{
-		snapPointMap.Add(snapPlayerPoint2, nullptr);
-		//set state machine to liberate the player
-		return;
+		GetWorld()->GetTimerManager().SetTimer(cooldownTimer, this, &AMiniGameSystem::Reset, cooldownTime, false);
 	}
-	
-	if (snapPointMap.Find(snapPlayerPoint1)[0] == nullptr)
+	else
 	{
-		snapPointMap.Add(snapPlayerPoint1, Player);
-		Player->SetActorLocation(snapPlayerPoint1->GetComponentLocation());
-		//set state machine to stopped /occupied / not moving or something
+		Reset();
 	}
-	else if (snapPointMap.Find(snapPlayerPoint2)[0] == nullptr)
+}
+
+void AMiniGameSystem::Reset()
+{
+	// Abandons any run in progress
+	StopQTESession();
+	GetWorldTimerManager().ClearTimer(cooldownTimer);
+	if (UProductionScheduler* scheduler = UProductionScheduler::Get(this))
 	{
-		snapPointMap.Add(snapPlayerPoint2, Player);
-		Player->SetActorLocation(snapPlayerPoint2->GetComponentLocation());
-		//set state machine to stopped /occupied / not moving or something
+		scheduler->Cancel(this);
 	}
 
-	if (snapPointMap.Find(snapPlayerPoint1) != nullptr && snapPointMap.Find(snapPlayerPoint2) != nullptr)
+	// Counters are rebuilt in place, the array keeps its memory
+	for (int32& count : missingItems)
 	{
-		StartExecute();
+		count = 0;
+	}
+	numMissingItems = 0;
+	loadedItems.Reset();
+	loadedItemTypes.Reset();
+
+	for (const FItemTypeId type : inputItemTypes)
+	{
+		if (!type.IsValid())
+		{
+			continue;
+		}
+		if (type.GetIndex() >= missingItems.Num())
+		{
+			missingItems.SetNumZeroed(type.GetIndex() + 1);
+		}
+		++missingItems[type.GetIndex()];
+		++numMissingItems;
+	}
+
+	SetState(numMissingItems == 0 ? EMachineState::Ready : EMachineState::Idle);
+}
+
+void AMiniGameSystem::Interact_Implementation(AMainPlayer* Player)
+{
+	const int32 playerSlot = snapPlayers.Find(Player);
+	if (playerSlot != INDEX_NONE)
+	{
+		snapPlayers[playerSlot] = nullptr;
+		//set state machine to liberate the player
+		return;
 	}
+	
+	const int32 freeSlot = snapPlayers.Find(nullptr);
+	if (freeSlot != INDEX_NONE)
+	{
+		snapPlayers[freeSlot] = Player;
+		Player->SetActorLocation(snapPoints[freeSlot]->GetComponentLocation());
+		//set state machine to stopped /occupied / not moving or something
+	}
+
+	StartExecute();
 }
 
 void AMiniGameSystem::InteractWithObject_Implementation(AMainPlayer* Player, AActor* Object)
@@ -247,16 +532,21 @@ void AMiniGameSystem::InteractWithObject_Implementation(AMainPlayer* Player, AAc
 		
 		if (item)
 		{
-			for (int i = 0; i < itemList.Num(); i++)
+			/* The type id is given by the class of the pickable */
+			const FItemTypeId type = item->GetItemTypeId();
+			if (NeedsItem(type))
 			{
-				if (itemList[i].GetDefaultObject()->GetItemName() == item->GetItemName())
+				--missingItems[type.GetIndex()];
+				--numMissingItems;
+				loadedItems.Add(type);
+				loadedItemTypes.Add(type);
+				SetState(numMissingItems == 0 ? EMachineState::Ready : EMachineState::Loading);
+				Player->PickUp();
+				if (UPickablePoolSubsystem* pool = UPickablePoolSubsystem::Get(this))
 				{
-					/* Get the name of the Object (name is given by the class of the pickable */
-					itemList.RemoveAt(i);
-					Player->PickUp();
-					Object->Destroy();
-					return;
+					pool->Release(item);
 				}
+				return;
 			}
 			IBCR_Helper::LogScreen(this, "Item not in itemList");
 		}
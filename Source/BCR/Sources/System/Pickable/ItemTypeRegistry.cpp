@@ -0,0 +1,58 @@
+#include "BCR/Headers/System/Pickable/ItemTypeRegistry.h"
+#include "BCR/Headers/System/Pickable/PickableItem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+UItemTypeRegistry* UItemTypeRegistry::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UItemTypeRegistry>() : nullptr;
+}
+
+void UItemTypeRegistry::Deinitialize()
+{
+	ClassIds.Reset();
+	KeyIds.Reset();
+	DisplayNames.Reset();
+	Super::Deinitialize();
+}
+
+FItemTypeId UItemTypeRegistry::Resolve(TSubclassOf<APickableItem> ItemClass)
+{
+	if (!ItemClass)
+	{
+		return FItemTypeId();
+	}
+
+	if (const FItemTypeId* Cached = ClassIds.Find(ItemClass.Get()))
+	{
+		return *Cached;
+	}
+
+	// First time this class is seen: its type comes from the asset, or from the legacy name
+	const APickableItem* Default = ItemClass.GetDefaultObject();
+	const UItemTypeAsset* TypeAsset = Default->GetItemType();
+	const FName Key = TypeAsset ? FName(TypeAsset->GetPathName()) : FName(Default->GetItemName());
+
+	FItemTypeId Id;
+	if (const FItemTypeId* Existing = KeyIds.Find(Key))
+	{
+		Id = *Existing;
+	}
+	else if (ensureMsgf(DisplayNames.Num() < FItemTypeId::InvalidValue, TEXT("Too many item types")))
+	{
+		Id = FItemTypeId(static_cast<uint16>(DisplayNames.Num()));
+		DisplayNames.Add(TypeAsset && !TypeAsset->DisplayName.IsEmpty() ? TypeAsset->DisplayName : Default->GetItemName());
+		KeyIds.Add(Key, Id);
+	}
+
+	ClassIds.Add(ItemClass.Get(), Id);
+	return Id;
+}
+
+const FString& UItemTypeRegistry::GetDisplayName(FItemTypeId Id) const
+{
+	static const FString Empty;
+	return DisplayNames.IsValidIndex(Id.GetIndex()) ? DisplayNames[Id.GetIndex()] : Empty;
+}
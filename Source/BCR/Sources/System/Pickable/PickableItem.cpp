@@ -1,10 +1,13 @@
 #include "BCR/Headers/System/Pickable/PickableItem.h"
+#include "BCR/Headers/System/MiniGame/MachineRegistry.h"
+#include "BCR/Headers/System/Interaction/InteractionIndex.h"
+#include "Components/PrimitiveComponent.h"
 
 // Sets default values
 APickableItem::APickableItem()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Items never tick: hundreds of them can lie around for free
+	PrimaryActorTick.bCanEverTick = false;
 
 }
 
@@ -12,20 +15,61 @@ APickableItem::APickableItem()
 void APickableItem::BeginPlay()
 {
 	Super::BeginPlay();
-	
-}
-
-// Called every frame
-void APickableItem::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
 
+	if (UItemTypeRegistry* registry = UItemTypeRegistry::Get(this))
+	{
+		itemTypeId = registry->Resolve(GetClass());
+	}
 }
 
 void APickableItem::PickedUp_Implementation(AActor* _player, AActor* _object)
 {
 	SetActorLocation(FVector(_player->GetActorLocation().X, _player->GetActorLocation().Y, _player->GetActorLocation().Z + 150));
 	IIPickable::PickedUp_Implementation(_player, _object);
+
+	// Machines waiting for this item start streaming their QTE before the player reaches them
+	if (const UMachineRegistry* machines = UMachineRegistry::Get(this))
+	{
+		machines->NotifyItemPickedUp(this);
+	}
+}
+
+void APickableItem::ActivateFromPool(const FTransform& _transform)
+{
+	SetActorTransform(_transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(bPooledTick);
+
+	if (UPrimitiveComponent* primitive = Cast<UPrimitiveComponent>(GetRootComponent()))
+	{
+		primitive->SetSimulatePhysics(bPooledPhysics);
+	}
+	bIsPooled = false;
+
+	if (UInteractionIndex* index = UInteractionIndex::Get(this))
+	{
+		index->UpdateActor(this);
+	}
 }
 
+void APickableItem::DeactivateToPool()
+{
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	bPooledTick = IsActorTickEnabled();
+	SetActorTickEnabled(false);
+
+	if (UPrimitiveComponent* primitive = Cast<UPrimitiveComponent>(GetRootComponent()))
+	{
+		bPooledPhysics = primitive->IsSimulatingPhysics();
+		primitive->SetSimulatePhysics(false);
+	}
+	bIsPooled = true;
 
+	if (UInteractionIndex* index = UInteractionIndex::Get(this))
+	{
+		index->Unregister(this);
+	}
+}
@@ -0,0 +1,173 @@
+#include "BCR/Headers/System/Pickable/PickablePool.h"
+#include "BCR/Headers/System/Pickable/PickableItem.h"
+#include "BCR/Headers/Interfaces/BCR_Helper.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_STATS_GROUP(TEXT("Pickable"), STATGROUP_Pickable, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Acquire"), STAT_PickableAcquire, STATGROUP_Pickable);
+DECLARE_CYCLE_STAT(TEXT("Release"), STAT_PickableRelease, STATGROUP_Pickable);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawns"), STAT_PickableSpawns, STATGROUP_Pickable);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reuses"), STAT_PickableReuses, STATGROUP_Pickable);
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs PickablePoolStressCommand(
+	TEXT("Pickable.PoolStress"),
+	TEXT("Pickable.PoolStress [Machines=10] [Cycles=200] [ItemClass] : compares spawn/destroy with the pickable pool"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UPickablePoolSubsystem* pool = UPickablePoolSubsystem::Get(World))
+		{
+			const int32 numMachines = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10;
+			const int32 numCycles = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 200;
+			UClass* itemClass = Args.Num() > 2 ? LoadClass<APickableItem>(nullptr, *Args[2]) : APickableItem::StaticClass();
+			pool->RunStressTest(itemClass, FMath::Max(1, numMachines), FMath::Max(1, numCycles));
+		}
+	}));
+#endif
+
+UPickablePoolSubsystem* UPickablePoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UPickablePoolSubsystem>() : nullptr;
+}
+
+void UPickablePoolSubsystem::Deinitialize()
+{
+	// The world destroys the actors themselves
+	FreeItems.Empty();
+	Super::Deinitialize();
+}
+
+APickableItem* UPickablePoolSubsystem::SpawnItem(TSubclassOf<APickableItem> ItemClass, const FTransform& Transform) const
+{
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	INC_DWORD_STAT(STAT_PickableSpawns);
+	return GetWorld()->SpawnActor<APickableItem>(ItemClass, Transform, SpawnInfo);
+}
+
+void UPickablePoolSubsystem::Prewarm(TSubclassOf<APickableItem> ItemClass, int32 Count)
+{
+	if (!ItemClass)
+	{
+		return;
+	}
+
+	FPickablePoolEntry& Pool = FreeItems.FindOrAdd(ItemClass.Get());
+	Pool.Items.Reserve(Pool.Items.Num() + Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (APickableItem* Item = SpawnItem(ItemClass, FTransform::Identity))
+		{
+			Item->DeactivateToPool();
+			Pool.Items.Add(Item);
+		}
+	}
+}
+
+APickableItem* UPickablePoolSubsystem::Acquire(TSubclassOf<APickableItem> ItemClass, const FTransform& Transform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickableAcquire);
+
+	if (!ItemClass)
+	{
+		return nullptr;
+	}
+
+	if (FPickablePoolEntry* Pool = FreeItems.Find(ItemClass.Get()))
+	{
+		while (Pool->Items.Num() > 0)
+		{
+			// An item may have been destroyed by something else while pooled
+			APickableItem* Item = Pool->Items.Pop(EAllowShrinking::No);
+			if (IsValid(Item))
+			{
+				INC_DWORD_STAT(STAT_PickableReuses);
+				Item->ActivateFromPool(Transform);
+				return Item;
+			}
+		}
+	}
+
+	return SpawnItem(ItemClass, Transform);
+}
+
+void UPickablePoolSubsystem::Release(APickableItem* Item)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickableRelease);
+
+	if (!IsValid(Item) || Item->IsPooled())
+	{
+		return;
+	}
+
+	Item->DeactivateToPool();
+	FreeItems.FindOrAdd(Item->GetClass()).Items.Add(Item);
+}
+
+int32 UPickablePoolSubsystem::GetNumFree(TSubclassOf<APickableItem> ItemClass) const
+{
+	const FPickablePoolEntry* Pool = FreeItems.Find(ItemClass.Get());
+	return Pool ? Pool->Items.Num() : 0;
+}
+
+void UPickablePoolSubsystem::RunStressTest(TSubclassOf<APickableItem> ItemClass, int32 NumMachines, int32 NumCycles)
+{
+#if !UE_BUILD_SHIPPING
+	if (!ItemClass)
+	{
+		return;
+	}
+
+	// Each cycle, every machine produces one item and consumes one
+	TArray<APickableItem*> Produced;
+	Produced.Reserve(NumMachines);
+
+	auto RunMode = [&](bool bUsePool, double& OutSpawnSeconds, double& OutGCSeconds)
+	{
+		OutSpawnSeconds = 0.0;
+		for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+		{
+			const double SpawnStart = FPlatformTime::Seconds();
+			for (int32 Machine = 0; Machine < NumMachines; ++Machine)
+			{
+				const FTransform Transform(FVector(Machine * 200.0f, 0.0f, -10000.0f));
+				Produced.Add(bUsePool ? Acquire(ItemClass, Transform) : SpawnItem(ItemClass, Transform));
+			}
+			OutSpawnSeconds += FPlatformTime::Seconds() - SpawnStart;
+
+			for (APickableItem* Item : Produced)
+			{
+				if (bUsePool)
+				{
+					Release(Item);
+				}
+				else if (Item)
+				{
+					Item->Destroy();
+				}
+			}
+			Produced.Reset();
+		}
+
+		const double GCStart = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		OutGCSeconds = FPlatformTime::Seconds() - GCStart;
+	};
+
+	// The pool is warmed first: steady state is what a running factory sees
+	Prewarm(ItemClass, FMath::Max(0, NumMachines - GetNumFree(ItemClass)));
+
+	double SpawnSeconds = 0.0, GCSeconds = 0.0, PoolSeconds = 0.0, PoolGCSeconds = 0.0;
+	RunMode(false, SpawnSeconds, GCSeconds);
+	RunMode(true, PoolSeconds, PoolGCSeconds);
+
+	const int32 NumItems = NumMachines * NumCycles;
+	IBCR_Helper::LogAll(this, FString::Printf(
+		TEXT("Pickable stress: %d machines x %d cycles | spawn %.2f us/item, GC %.2f ms | pool %.2f us/item, GC %.2f ms"),
+		NumMachines, NumCycles, SpawnSeconds * 1e6 / NumItems, GCSeconds * 1000.0, PoolSeconds * 1e6 / NumItems, PoolGCSeconds * 1000.0),
+		10.0f, FColor::Cyan);
+#endif
+}
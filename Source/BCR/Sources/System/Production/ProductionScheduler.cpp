@@ -0,0 +1,79 @@
+#include "BCR/Headers/System/Production/ProductionScheduler.h"
+#include "BCR/Headers/System/MiniGame/MiniGameSystem.h"
+#include "Engine/World.h"
+
+DECLARE_STATS_GROUP(TEXT("Production"), STATGROUP_Production, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Scheduler Tick"), STAT_ProductionTick, STATGROUP_Production);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Jobs"), STAT_ProductionPending, STATGROUP_Production);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dispatched Jobs"), STAT_ProductionDispatched, STATGROUP_Production);
+
+UProductionScheduler* UProductionScheduler::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UProductionScheduler>() : nullptr;
+}
+
+void UProductionScheduler::Deinitialize()
+{
+	Jobs.Empty();
+	DueJobs.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UProductionScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProductionScheduler, STATGROUP_Tickables);
+}
+
+void UProductionScheduler::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProductionTick);
+	SET_DWORD_STAT(STAT_ProductionPending, Jobs.Num());
+
+	if (bIsPaused)
+	{
+		return;
+	}
+	Clock += DeltaTime;
+
+	// Most frames end here: the heap top is the soonest job
+	if (Jobs.Num() == 0 || Jobs.HeapTop().DueTime > Clock)
+	{
+		return;
+	}
+
+	while (Jobs.Num() > 0 && Jobs.HeapTop().DueTime <= Clock)
+	{
+		FProductionJob& Job = DueJobs.AddDefaulted_GetRef();
+		Jobs.HeapPop(Job, EAllowShrinking::No);
+	}
+
+	INC_DWORD_STAT_BY(STAT_ProductionDispatched, DueJobs.Num());
+	for (const FProductionJob& Job : DueJobs)
+	{
+		if (AMiniGameSystem* Machine = Job.Machine.Get())
+		{
+			Machine->SpawnItem(Job.OutputIndex);
+		}
+	}
+	DueJobs.Reset();
+}
+
+void UProductionScheduler::Schedule(AMiniGameSystem* Machine, int32 OutputIndex, double Delay)
+{
+	FProductionJob Job;
+	Job.DueTime = Clock + FMath::Max(0.0, Delay);
+	Job.Machine = Machine;
+	Job.OutputIndex = OutputIndex;
+	Job.Sequence = NextSequence++;
+	Jobs.HeapPush(Job);
+}
+
+void UProductionScheduler::Cancel(const AMiniGameSystem* Machine)
+{
+	const int32 NumRemoved = Jobs.RemoveAllSwap([Machine](const FProductionJob& Job) { return Job.Machine.Get() == Machine; }, EAllowShrinking::No);
+	if (NumRemoved > 0)
+	{
+		Jobs.Heapify();
+	}
+}
@@ -1,27 +1,39 @@
 ﻿#include "BCR/Headers/System/QTE/QTEConfigurationTypes.h"
 #include "BCR/Headers/Interfaces/BCR_Helper.h"
 
-FQTEConfiguration UQTEConfigurationAsset::ToRuntimeConfig() const
+TSharedRef<const FQTEProgram> UQTEConfigurationAsset::GetProgram() const
 {
-    FQTEConfiguration RuntimeConfig;
-    
-    RuntimeConfig.ConfigurationName = ConfigurationName;
-    RuntimeConfig.TotalTime = Configuration.TotalTime;
-    RuntimeConfig.WidgetClass = Configuration.WidgetClass;
-    RuntimeConfig.SnapPoints = Configuration.SnapPoints;
-
-    // Validation
-    if (RuntimeConfig.SnapPoints.Num() == 0)
+    if (!CompiledProgram.IsValid())
     {
-        IBCR_Helper::LogScreen(this, TEXT("Configuration invalide : aucun snap point configuré"),
-            5.0f, FColor::Red);
+        CompileProgram();
     }
-    
-    if (RuntimeConfig.SnapPoints.Num() > 2)
+    return CompiledProgram.ToSharedRef();
+}
+
+void UQTEConfigurationAsset::PostLoad()
+{
+    Super::PostLoad();
+    CompileProgram();
+}
+
+#if WITH_EDITOR
+void UQTEConfigurationAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Les sessions en cours gardent l'ancien programme, les suivantes utilisent le nouveau
+    CompileProgram();
+}
+#endif
+
+void UQTEConfigurationAsset::CompileProgram() const
+{
+    FQTEConfiguration Source = Configuration;
+    Source.ConfigurationName = ConfigurationName;
+    CompiledProgram = FQTEProgram::Compile(Source);
+
+    if (!CompiledProgram->IsValid())
     {
-        IBCR_Helper::LogScreen(this, TEXT("Configuration invalide : trop de snap points configurés"),
-            5.0f, FColor::Red);
+        IBCR_Helper::LogConsole(this, CompiledProgram->GetError());
     }
-
-    return RuntimeConfig;
 }
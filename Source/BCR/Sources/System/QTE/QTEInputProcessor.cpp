@@ -0,0 +1,52 @@
+﻿#include "BCR/Headers/System/QTE/QTEInputProcessor.h"
+#include "Input/Events.h"
+
+FQTEInputProcessor::FQTEInputProcessor(FOnQTEInputEvent InOnInputEvent)
+    : OnInputEvent(MoveTemp(InOnInputEvent))
+{
+}
+
+bool FQTEInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+    // Les répétitions automatiques de l'OS ne sont pas de vrais appuis
+    if (!InKeyEvent.IsRepeat())
+    {
+        Capture(InKeyEvent, EQTEInputEventType::Pressed);
+    }
+    return false;
+}
+
+bool FQTEInputProcessor::HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+    Capture(InKeyEvent, EQTEInputEventType::Released);
+    return false;
+}
+
+bool FQTEInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent)
+{
+    // Seul le stick gauche sert aux actions Rotate
+    const FKey Key = InAnalogInputEvent.GetKey();
+    if (Key == EKeys::Gamepad_LeftX || Key == EKeys::Gamepad_LeftY)
+    {
+        FQTEInputEvent Event;
+        Event.Key = Key;
+        Event.Type = EQTEInputEventType::Axis;
+        Event.UserIndex = InAnalogInputEvent.GetUserIndex();
+        Event.Timestamp = FPlatformTime::Seconds();
+        Event.AxisValue = InAnalogInputEvent.GetAnalogValue();
+
+        OnInputEvent.ExecuteIfBound(Event);
+    }
+    return false;
+}
+
+void FQTEInputProcessor::Capture(const FKeyEvent& InKeyEvent, EQTEInputEventType Type) const
+{
+    FQTEInputEvent Event;
+    Event.Key = InKeyEvent.GetKey();
+    Event.Type = Type;
+    Event.UserIndex = InKeyEvent.GetUserIndex();
+    Event.Timestamp = FPlatformTime::Seconds();
+
+    OnInputEvent.ExecuteIfBound(Event);
+}
@@ -0,0 +1,114 @@
+﻿#include "BCR/Headers/System/QTE/QTEPreloader.h"
+
+TSharedPtr<FQTEPreloadRequest> FQTEPreloader::Preload(const TSoftObjectPtr<UQTEConfigurationAsset>& Config, FSimpleDelegate OnLoaded)
+{
+    if (Config.IsNull())
+    {
+        return nullptr;
+    }
+
+    const FSoftObjectPath Path = Config.ToSoftObjectPath();
+    TSharedPtr<FQTEPreloadRequest> Request = Requests.FindRef(Path).Pin();
+
+    if (!Request.IsValid())
+    {
+        // Nettoie les requêtes abandonnées par toutes les machines
+        for (auto It = Requests.CreateIterator(); It; ++It)
+        {
+            if (!It.Value().IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        Request = MakeShared<FQTEPreloadRequest>();
+        Request->Config = Config;
+        Request->RequestTime = FPlatformTime::Seconds();
+        Requests.Add(Path, Request);
+
+        Request->OnLoaded.Add(OnLoaded);
+        Request->ConfigHandle = StreamableManager.RequestAsyncLoad(Path,
+            FStreamableDelegate::CreateRaw(this, &FQTEPreloader::OnConfigLoaded, TWeakPtr<FQTEPreloadRequest>(Request)));
+        return Request;
+    }
+
+    if (Request->bIsLoaded)
+    {
+        OnLoaded.ExecuteIfBound();
+    }
+    else
+    {
+        Request->OnLoaded.Add(OnLoaded);
+    }
+    return Request;
+}
+
+void FQTEPreloader::LogReport() const
+{
+    int64 TotalBytes = 0;
+    int32 NumResident = 0;
+
+    for (const TPair<FSoftObjectPath, TWeakPtr<FQTEPreloadRequest>>& Pair : Requests)
+    {
+        const TSharedPtr<FQTEPreloadRequest> Request = Pair.Value.Pin();
+        if (!Request.IsValid())
+        {
+            continue;
+        }
+
+        // Asset et classe du widget, sous-objets compris
+        int64 Bytes = 0;
+        if (UQTEConfigurationAsset* Config = Request->Config.Get())
+        {
+            Bytes += Config->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+            if (UClass* WidgetClass = Config->Configuration.WidgetClass.Get())
+            {
+                Bytes += WidgetClass->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+            }
+        }
+
+        TotalBytes += Bytes;
+        NumResident += Request->bIsLoaded ? 1 : 0;
+        UE_LOG(LogTemp, Log, TEXT("QTE preload: %s %s, %.1f KB, loaded in %.1f ms"), *Pair.Key.ToString(),
+            Request->bIsLoaded ? TEXT("resident") : TEXT("loading"), Bytes / 1024.0, Request->LoadDuration * 1000.0);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("QTE preload: %d resident assets, %.1f KB"), NumResident, TotalBytes / 1024.0);
+}
+
+void FQTEPreloader::OnConfigLoaded(TWeakPtr<FQTEPreloadRequest> WeakRequest)
+{
+    const TSharedPtr<FQTEPreloadRequest> Request = WeakRequest.Pin();
+    if (!Request.IsValid())
+    {
+        return;
+    }
+
+    // Le widget n'est connu qu'une fois l'asset chargé : second passage, sans bloquer
+    const UQTEConfigurationAsset* Config = Request->Config.Get();
+    const FSoftObjectPath WidgetPath = Config ? Config->Configuration.WidgetClass.ToSoftObjectPath() : FSoftObjectPath();
+    if (WidgetPath.IsNull())
+    {
+        OnWidgetLoaded(WeakRequest);
+        return;
+    }
+
+    Request->WidgetHandle = StreamableManager.RequestAsyncLoad(WidgetPath,
+        FStreamableDelegate::CreateRaw(this, &FQTEPreloader::OnWidgetLoaded, WeakRequest));
+}
+
+void FQTEPreloader::OnWidgetLoaded(TWeakPtr<FQTEPreloadRequest> WeakRequest)
+{
+    const TSharedPtr<FQTEPreloadRequest> Request = WeakRequest.Pin();
+    if (!Request.IsValid() || Request->bIsLoaded)
+    {
+        return;
+    }
+
+    Request->bIsLoaded = true;
+    Request->LoadDuration = FPlatformTime::Seconds() - Request->RequestTime;
+
+    // Les abonnés peuvent relâcher leur référence pendant la diffusion
+    FSimpleMulticastDelegate OnLoaded = MoveTemp(Request->OnLoaded);
+    OnLoaded.Broadcast();
+}
@@ -0,0 +1,274 @@
+﻿#include "BCR/Headers/System/QTE/QTEProgram.h"
+#include "BCR/Headers/System/QTE/QTE_Subsystem.h"
+
+//////// VALIDATEURS POLLING ////////
+static int32 ValidateNoAction(const FQTEInputSample& Sample, const FSnapPointConfig& Config, FQTEProgressData& Progress)
+{
+    return 0;
+}
+
+static int32 ValidateHoldAction(const FQTEInputSample& Sample, const FSnapPointConfig& Config, FQTEProgressData& Progress)
+{
+    if (!Sample.bIsDown)
+    {
+        Progress.bIsHeld = false;
+        return 0;
+    }
+
+    if (!Progress.bIsHeld)
+    {
+        Progress.bIsHeld = true;
+        Progress.HoldStartTime = Sample.Time;
+        Progress.HoldCredited = 0;
+    }
+
+    // Un succès par intervalle maintenu, indépendamment de la fréquence des frames
+    const int32 Successes = FMath::FloorToInt32((Sample.Time - Progress.HoldStartTime) / UQTE_Subsystem::ProcessInterval) - Progress.HoldCredited;
+    Progress.HoldCredited += Successes;
+    return Successes;
+}
+
+static int32 ValidateRotateAction(const FQTEInputSample& Sample, const FSnapPointConfig& Config, FQTEProgressData& Progress)
+{
+    // Un tour complet de plus, dans le même sens, à la vitesse minimale requise
+    if (FMath::Abs(Sample.AngularVelocity) < Config.MinRotationSpeed)
+    {
+        return 0;
+    }
+
+    if (FMath::FloorToInt32(FMath::Abs(Sample.Revolutions)) <= Progress.RevolutionsCredited)
+    {
+        return 0;
+    }
+
+    ++Progress.RevolutionsCredited;
+    return 1;
+}
+
+static int32 ValidatePressAction(const FQTEInputSample& Sample, const FSnapPointConfig& Config, FQTEProgressData& Progress)
+{
+    return Sample.bJustPressed ? 1 : 0;
+}
+
+static int32 ValidateReleaseAction(const FQTEInputSample& Sample, const FSnapPointConfig& Config, FQTEProgressData& Progress)
+{
+    return Sample.bJustReleased ? 1 : 0;
+}
+
+//////// VALIDATEURS EVENEMENTS ////////
+static int32 ValidateNoEvent(const FQTEInputEvent& Event, FQTEProgressData& Progress)
+{
+    // Le stick analogique n'émet pas d'événements de touche
+    return 0;
+}
+
+static int32 ValidatePressEvent(const FQTEInputEvent& Event, FQTEProgressData& Progress)
+{
+    return Event.Type == EQTEInputEventType::Pressed ? 1 : 0;
+}
+
+static int32 ValidateReleaseEvent(const FQTEInputEvent& Event, FQTEProgressData& Progress)
+{
+    return Event.Type == EQTEInputEventType::Released ? 1 : 0;
+}
+
+static int32 ValidateHoldEvent(const FQTEInputEvent& Event, FQTEProgressData& Progress)
+{
+    if (Event.Type == EQTEInputEventType::Pressed)
+    {
+        Progress.bIsHeld = true;
+        Progress.HoldStartTime = Event.Timestamp;
+        Progress.HoldCredited = 0;
+        return 0;
+    }
+
+    if (!Progress.bIsHeld)
+    {
+        return 0;
+    }
+
+    // Crédite le temps maintenu jusqu'au relâchement exact
+    Progress.bIsHeld = false;
+    return FMath::FloorToInt32((Event.Timestamp - Progress.HoldStartTime) / UQTE_Subsystem::ProcessInterval) - Progress.HoldCredited;
+}
+
+FQTEConfiguration FQTEProgram::MakeConfiguration() const
+{
+    FQTEConfiguration Config;
+    Config.ConfigurationName = ConfigurationName;
+    Config.TotalTime = TotalTime;
+    Config.InputMode = InputMode;
+    Config.WidgetClass = WidgetClass;
+
+    for (int32 StageIndex = 0; StageIndex < Stages.Num(); ++StageIndex)
+    {
+        const FQTECompiledStage& Stage = Stages[StageIndex];
+        TArray<FSnapPointConfig>& SnapPoints = bHasStageGraph ? Config.Stages.AddDefaulted_GetRef().SnapPoints : Config.SnapPoints;
+
+        for (ESnapPointType SnapPoint : Stage.UsedSnapPoints)
+        {
+            SnapPoints.Add(Stage.GetSnapPoint(SnapPoint)->Config);
+        }
+
+        if (bHasStageGraph)
+        {
+            FQTEStageConfig& StageConfig = Config.Stages.Last();
+            StageConfig.StageName = Stage.Name;
+            StageConfig.TimeLimit = Stage.TimeLimit;
+
+            const int32 OnSuccess = GetTransition(StageIndex, true);
+            const int32 OnFailure = GetTransition(StageIndex, false);
+            StageConfig.OnSuccess = OnSuccess >= 0 ? Stages[OnSuccess].Name : NAME_None;
+            StageConfig.OnFailure = OnFailure >= 0 ? Stages[OnFailure].Name : NAME_None;
+        }
+    }
+    return Config;
+}
+
+bool FQTEProgram::CompileStage(const FQTEStageConfig& StageConfig, FQTECompiledStage& Stage)
+{
+    Stage.Name = StageConfig.StageName;
+    Stage.TimeLimit = StageConfig.TimeLimit;
+
+    bool bHasDuplicate = false;
+
+    for (const FSnapPointConfig& SnapConfig : StageConfig.SnapPoints)
+    {
+        const int32 Index = static_cast<int32>(SnapConfig.SnapPointType);
+        if (Index < 0 || Index >= QTESnapPointTypeCount)
+        {
+            continue;
+        }
+
+        FQTECompiledSnapPoint& Compiled = Stage.SnapPoints[Index];
+        bHasDuplicate |= Compiled.bIsUsed;
+
+        Compiled.Config = SnapConfig;
+        Compiled.bIsUsed = true;
+
+        switch (SnapConfig.ActionType)
+        {
+        case EQTEActionType::Press:
+            Compiled.PollValidator = &ValidatePressAction;
+            Compiled.EventValidator = &ValidatePressEvent;
+            break;
+        case EQTEActionType::Hold:
+            Compiled.PollValidator = &ValidateHoldAction;
+            Compiled.EventValidator = &ValidateHoldEvent;
+            break;
+        case EQTEActionType::Release:
+            Compiled.PollValidator = &ValidateReleaseAction;
+            Compiled.EventValidator = &ValidateReleaseEvent;
+            break;
+        case EQTEActionType::Rotate:
+            Compiled.PollValidator = &ValidateRotateAction;
+            Compiled.EventValidator = &ValidateNoEvent;
+            break;
+        case EQTEActionType::None:
+        default:
+            Compiled.PollValidator = &ValidateNoAction;
+            Compiled.EventValidator = &ValidateNoEvent;
+            break;
+        }
+
+        // Repères triés une fois : le jugement avance un curseur sans jamais les reparcourir
+        Compiled.Cues.Reset();
+        if (SnapConfig.ActionType == EQTEActionType::Press || SnapConfig.ActionType == EQTEActionType::Release)
+        {
+            for (float CueTime : SnapConfig.CueTimes)
+            {
+                Compiled.Cues.Add(CueTime);
+            }
+            Compiled.Cues.Sort();
+        }
+
+        if (Compiled.IsTimed())
+        {
+            Compiled.Config.GoodWindow = FMath::Max(Compiled.Config.GoodWindow, Compiled.Config.PerfectWindow);
+            if (Compiled.Config.RepeatCount < 0 || Compiled.Config.RepeatCount > Compiled.Cues.Num())
+            {
+                Compiled.Config.RepeatCount = Compiled.Cues.Num();
+            }
+        }
+
+        Stage.UsedSnapPoints.AddUnique(SnapConfig.SnapPointType);
+        Participants.AddUnique(SnapConfig.SnapPointType);
+    }
+
+    return StageConfig.SnapPoints.Num() > 0
+        && StageConfig.SnapPoints.Num() <= QTESnapPointTypeCount
+        && !bHasDuplicate;
+}
+
+TSharedRef<const FQTEProgram> FQTEProgram::Compile(const FQTEConfiguration& Config)
+{
+    TSharedRef<FQTEProgram> Program = MakeShared<FQTEProgram>();
+
+    Program->ConfigurationName = Config.ConfigurationName;
+    Program->TotalTime = Config.TotalTime;
+    Program->InputMode = Config.InputMode;
+    Program->WidgetClass = Config.WidgetClass;
+    Program->bHasStageGraph = Config.Stages.Num() > 0;
+
+    // Une configuration plate est une étape unique qui termine le QTE
+    TArray<FQTEStageConfig> ImplicitStage;
+    if (!Program->bHasStageGraph)
+    {
+        ImplicitStage.AddDefaulted_GetRef().SnapPoints = Config.SnapPoints;
+    }
+    const TArray<FQTEStageConfig>& StageConfigs = Program->bHasStageGraph ? Config.Stages : ImplicitStage;
+
+    Program->Stages.SetNum(StageConfigs.Num());
+    Program->Transitions.Init(QTEStageFailed, StageConfigs.Num() * 2);
+    Program->bIsValid = true;
+
+    // Résout une cible nommée en index d'étape
+    auto ResolveStage = [&StageConfigs, &Program](FName Target, int32 Default) -> int32
+    {
+        if (Target.IsNone())
+        {
+            return Default;
+        }
+
+        const int32 Index = StageConfigs.IndexOfByPredicate([Target](const FQTEStageConfig& Stage) { return Stage.StageName == Target; });
+        if (Index == INDEX_NONE)
+        {
+            Program->bIsValid = false;
+            Program->Error = FString::Printf(TEXT("Configuration invalide : l'étape %s n'existe pas"), *Target.ToString());
+        }
+        return Index == INDEX_NONE ? Default : Index;
+    };
+
+    for (int32 StageIndex = 0; StageIndex < StageConfigs.Num(); ++StageIndex)
+    {
+        const FQTEStageConfig& StageConfig = StageConfigs[StageIndex];
+
+        if (!Program->CompileStage(StageConfig, Program->Stages[StageIndex]))
+        {
+            Program->bIsValid = false;
+            Program->Error = FString::Printf(
+                TEXT("Configuration invalide : le nombre de snap points doit être compris entre 1 et %d, sans doublon (étape %d)"),
+                QTESnapPointTypeCount, StageIndex);
+        }
+
+        for (int32 OtherIndex = 0; OtherIndex < StageIndex; ++OtherIndex)
+        {
+            if (Program->bHasStageGraph && StageConfigs[OtherIndex].StageName == StageConfig.StageName)
+            {
+                Program->bIsValid = false;
+                Program->Error = FString::Printf(TEXT("Configuration invalide : l'étape %s est définie deux fois"), *StageConfig.StageName.ToString());
+            }
+        }
+
+        Program->Transitions[StageIndex * 2] = ResolveStage(StageConfig.OnSuccess, QTEStageComplete);
+        Program->Transitions[StageIndex * 2 + 1] = ResolveStage(StageConfig.OnFailure, QTEStageFailed);
+    }
+
+    if (Program->Stages.Num() == 0)
+    {
+        Program->bIsValid = false;
+        Program->Error = TEXT("Configuration invalide : aucune étape");
+    }
+
+    return Program;
+}
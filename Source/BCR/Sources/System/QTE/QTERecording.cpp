@@ -0,0 +1,213 @@
+﻿#include "BCR/Headers/System/QTE/QTERecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    constexpr uint32 RecordingMagic = 0x43525451; // "QTRC"
+    constexpr uint32 RecordingVersion = 4;
+
+    // Borne de lecture : protège contre un fichier corrompu
+    constexpr int32 MaxStages = 256;
+
+    // Bits des drapeaux d'un échantillon
+    constexpr uint8 SampleDown = 1 << 0;
+    constexpr uint8 SampleJustPressed = 1 << 1;
+    constexpr uint8 SampleJustReleased = 1 << 2;
+    constexpr uint8 SampleHasStick = 1 << 3;
+
+    bool SerializeSnapPoints(FArchive& Ar, TArray<FSnapPointConfig>& SnapPoints)
+    {
+        int32 NumSnapPoints = SnapPoints.Num();
+        Ar << NumSnapPoints;
+        if (Ar.IsLoading())
+        {
+            if (NumSnapPoints < 0 || NumSnapPoints > QTESnapPointTypeCount)
+            {
+                Ar.SetError();
+                return false;
+            }
+            SnapPoints.SetNum(NumSnapPoints);
+        }
+
+        for (FSnapPointConfig& SnapConfig : SnapPoints)
+        {
+            uint8 SnapPointType = static_cast<uint8>(SnapConfig.SnapPointType);
+            uint8 ActionType = static_cast<uint8>(SnapConfig.ActionType);
+            FString KeyName = SnapConfig.RequiredInput.ToString();
+            Ar << SnapPointType << ActionType << KeyName << SnapConfig.RepeatCount << SnapConfig.MinRotationSpeed;
+            Ar << SnapConfig.CueTimes << SnapConfig.PerfectWindow << SnapConfig.GoodWindow;
+
+            if (Ar.IsLoading())
+            {
+                SnapConfig.SnapPointType = static_cast<ESnapPointType>(SnapPointType);
+                SnapConfig.ActionType = static_cast<EQTEActionType>(ActionType);
+                SnapConfig.RequiredInput = FKey(*KeyName);
+            }
+        }
+        return !Ar.IsError();
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FQTERecordEntry& Entry)
+{
+    Ar << Entry.Time;
+
+    // Type (3 bits), type d'événement (1 bit) et snap point (3 bits) tiennent dans un octet
+    uint8 Header = static_cast<uint8>(Entry.Type)
+        | (static_cast<uint8>(Entry.EventType) << 3)
+        | (static_cast<uint8>(Entry.SnapPoint) << 4);
+    Ar << Header;
+
+    if (Ar.IsLoading())
+    {
+        Entry.Type = static_cast<EQTERecordEntryType>(Header & 0x7);
+        Entry.EventType = static_cast<EQTEInputEventType>((Header >> 3) & 0x1);
+        Entry.SnapPoint = static_cast<ESnapPointType>((Header >> 4) & 0x7);
+    }
+
+    if (Entry.Type == EQTERecordEntryType::StageEnd)
+    {
+        // Issue (1 bit) et cause dans un octet
+        uint8 Outcome = (Entry.bStageSucceeded ? 1 : 0) | (static_cast<uint8>(Entry.Cause) << 1);
+        Ar << Entry.StageSerial << Outcome;
+
+        if (Ar.IsLoading())
+        {
+            Entry.bStageSucceeded = (Outcome & 0x1) != 0;
+            Entry.Cause = static_cast<EQTEFailureCause>(Outcome >> 1);
+        }
+    }
+
+    if (Entry.Type != EQTERecordEntryType::Sample)
+    {
+        return Ar;
+    }
+
+    FQTEInputSample& Sample = Entry.Sample;
+    uint8 Flags = (Sample.bIsDown ? SampleDown : 0)
+        | (Sample.bJustPressed ? SampleJustPressed : 0)
+        | (Sample.bJustReleased ? SampleJustReleased : 0)
+        | (Sample.StickPosition.IsZero() ? 0 : SampleHasStick);
+    Ar << Flags;
+
+    // Le stick est lu en float par le contrôleur : la conversion est exacte
+    FVector2f Stick(Sample.StickPosition);
+    if (Flags & SampleHasStick)
+    {
+        Ar << Stick;
+    }
+
+    if (Ar.IsLoading())
+    {
+        Sample.bIsDown = (Flags & SampleDown) != 0;
+        Sample.bJustPressed = (Flags & SampleJustPressed) != 0;
+        Sample.bJustReleased = (Flags & SampleJustReleased) != 0;
+        Sample.StickPosition = (Flags & SampleHasStick) ? FVector2D(Stick) : FVector2D::ZeroVector;
+    }
+
+    return Ar;
+}
+
+FQTERecording::FQTERecording()
+{
+    for (int32& Count : SuccessCounts)
+    {
+        Count = 0;
+    }
+}
+
+void FQTERecording::AddEntry(FQTERecordEntry&& Entry, double Now)
+{
+    Entry.Time = Now - StartTime;
+    Entries.Add(MoveTemp(Entry));
+}
+
+bool FQTERecording::MatchesResult(const FQTERecording& Other) const
+{
+    return bSuccess == Other.bSuccess && SuccessCounts == Other.SuccessCounts;
+}
+
+FArchive& operator<<(FArchive& Ar, FQTERecording& Recording)
+{
+    uint32 Magic = RecordingMagic;
+    uint32 Version = RecordingVersion;
+    Ar << Magic << Version;
+
+    if (Magic != RecordingMagic || Version != RecordingVersion)
+    {
+        Ar.SetError();
+        return Ar;
+    }
+
+    // Configuration (sans widget : inutile au rejeu)
+    FQTEConfiguration& Config = Recording.Configuration;
+    uint8 InputMode = static_cast<uint8>(Config.InputMode);
+    Ar << Config.ConfigurationName << Config.TotalTime << InputMode;
+    Config.InputMode = static_cast<EQTEInputMode>(InputMode);
+
+    if (!SerializeSnapPoints(Ar, Config.SnapPoints))
+    {
+        return Ar;
+    }
+
+    int32 NumStages = Config.Stages.Num();
+    Ar << NumStages;
+    if (Ar.IsLoading())
+    {
+        if (NumStages < 0 || NumStages > MaxStages)
+        {
+            Ar.SetError();
+            return Ar;
+        }
+        Config.Stages.SetNum(NumStages);
+    }
+
+    for (FQTEStageConfig& Stage : Config.Stages)
+    {
+        Ar << Stage.StageName << Stage.TimeLimit << Stage.OnSuccess << Stage.OnFailure;
+        if (!SerializeSnapPoints(Ar, Stage.SnapPoints))
+        {
+            return Ar;
+        }
+    }
+
+    // Résultat de référence
+    Ar << Recording.bSuccess;
+    for (int32& Count : Recording.SuccessCounts)
+    {
+        Ar << Count;
+    }
+
+    Ar << Recording.Entries;
+    return Ar;
+}
+
+bool FQTERecording::SaveToFile(const FString& Path) const
+{
+    TArray<uint8> Buffer;
+    FMemoryWriter Writer(Buffer);
+    Writer << const_cast<FQTERecording&>(*this);
+
+    return FFileHelper::SaveArrayToFile(Buffer, *Path);
+}
+
+bool FQTERecording::LoadFromFile(const FString& Path)
+{
+    TArray<uint8> Buffer;
+    if (!FFileHelper::LoadFileToArray(Buffer, *Path))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Buffer);
+    Reader << *this;
+    return !Reader.IsError();
+}
+
+FString FQTERecording::GetRecordingDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("QTE");
+}
@@ -0,0 +1,102 @@
+﻿#include "BCR/Headers/System/QTE/QTEStickSampler.h"
+
+FQTEStickSampler::FQTEStickSampler()
+{
+    Reset();
+}
+
+void FQTEStickSampler::Reset()
+{
+    for (float& Delta : DeltaAngles)
+    {
+        Delta = 0.0f;
+    }
+
+    Head = 0;
+    NumSamples = 0;
+    WindowSum = 0.0;
+    AccumulatedAngle = 0.0;
+    LastAngle = 0.0f;
+    bWasTracking = false;
+    LastReading = FVector2D::ZeroVector;
+    LastReadingTime = 0.0;
+    NextSampleTime = 0.0;
+    bHasReading = false;
+}
+
+void FQTEStickSampler::AddReading(const FVector2D& Stick, double Time)
+{
+    if (!bHasReading)
+    {
+        bHasReading = true;
+        LastReading = Stick;
+        LastReadingTime = Time;
+        NextSampleTime = Time + SampleInterval;
+        PushSample(Stick);
+        return;
+    }
+
+    // Après une longue interruption, seule la fin de l'intervalle peut entrer dans la fenêtre
+    const double MaxSpan = WindowSize * SampleInterval;
+    if (Time - NextSampleTime > MaxSpan)
+    {
+        NextSampleTime += FMath::FloorToDouble((Time - NextSampleTime - MaxSpan) / SampleInterval) * SampleInterval;
+    }
+
+    const double Span = Time - LastReadingTime;
+    while (NextSampleTime <= Time)
+    {
+        const double Alpha = Span > 0.0 ? FMath::Clamp((NextSampleTime - LastReadingTime) / Span, 0.0, 1.0) : 1.0;
+        PushSample(FMath::Lerp(LastReading, Stick, Alpha));
+        NextSampleTime += SampleInterval;
+    }
+
+    LastReading = Stick;
+    LastReadingTime = Time;
+}
+
+void FQTEStickSampler::PushSample(const FVector2D& Position)
+{
+    float Delta = 0.0f;
+    const bool bIsTracking = Position.SizeSquared() >= FMath::Square(DeadZone);
+
+    if (bIsTracking)
+    {
+        const float Angle = FMath::Atan2(Position.Y, Position.X);
+        if (bWasTracking)
+        {
+            Delta = FMath::FindDeltaAngleRadians(LastAngle, Angle);
+        }
+        LastAngle = Angle;
+    }
+    bWasTracking = bIsTracking;
+
+    // Remplace l'échantillon le plus ancien et met à jour la somme glissante
+    if (NumSamples == WindowSize)
+    {
+        WindowSum -= DeltaAngles[Head];
+    }
+    else
+    {
+        ++NumSamples;
+    }
+
+    DeltaAngles[Head] = Delta;
+    Head = (Head + 1) % WindowSize;
+    WindowSum += Delta;
+    AccumulatedAngle += Delta;
+}
+
+float FQTEStickSampler::GetAngularVelocity() const
+{
+    if (NumSamples == 0)
+    {
+        return 0.0f;
+    }
+    return static_cast<float>(WindowSum / (NumSamples * SampleInterval) / UE_DOUBLE_TWO_PI);
+}
+
+int32 FQTEStickSampler::GetDirection() const
+{
+    return static_cast<int32>(FMath::Sign(WindowSum));
+}
@@ -0,0 +1,212 @@
+﻿#include "BCR/Headers/System/QTE/QTETelemetry.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    FString GetFailureCauseName(int32 Cause)
+    {
+        return StaticEnum<EQTEFailureCause>()->GetNameStringByValue(Cause);
+    }
+
+    FString GetSnapPointName(int32 SnapPoint)
+    {
+        return StaticEnum<ESnapPointType>()->GetNameStringByValue(SnapPoint);
+    }
+
+    // Champ CSV entre guillemets (guillemets internes doublés) : une virgule dans un nom d'asset ne décale plus les colonnes
+    FString QuoteCSV(const FString& Field)
+    {
+        return TEXT("\"") + Field.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+    }
+
+    void AppendHistogramCSV(FString& Out, const FString& ConfigurationName, const FString& Scope, const TCHAR* Metric, const FQTEHistogram& Histogram)
+    {
+        Out += FString::Printf(TEXT("%s,%s,%s,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,"),
+            *QuoteCSV(ConfigurationName), *Scope, Metric, Histogram.Count, Histogram.GetMean(), Histogram.Min, Histogram.Max,
+            Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.9f), Histogram.BucketWidth);
+
+        for (int32 Bucket = 0; Bucket < Histogram.Buckets.Num(); ++Bucket)
+        {
+            Out += FString::Printf(Bucket > 0 ? TEXT(" %u") : TEXT("%u"), Histogram.Buckets[Bucket]);
+        }
+        Out += TEXT("\n");
+    }
+
+    void AppendCounterCSV(FString& Out, const FString& ConfigurationName, const FString& Scope, const FString& Metric, uint32 Count)
+    {
+        Out += FString::Printf(TEXT("%s,%s,%s,%u,,,,,,,\n"), *QuoteCSV(ConfigurationName), *Scope, *Metric, Count);
+    }
+
+    void AppendHistogramJSON(FString& Out, const TCHAR* Name, const FQTEHistogram& Histogram)
+    {
+        Out += FString::Printf(TEXT("\"%s\":{\"count\":%u,\"mean\":%.4f,\"min\":%.4f,\"max\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"bucketWidth\":%.3f,\"buckets\":["),
+            Name, Histogram.Count, Histogram.GetMean(), Histogram.Min, Histogram.Max,
+            Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.9f), Histogram.BucketWidth);
+
+        for (int32 Bucket = 0; Bucket < Histogram.Buckets.Num(); ++Bucket)
+        {
+            Out += FString::Printf(Bucket > 0 ? TEXT(",%u") : TEXT("%u"), Histogram.Buckets[Bucket]);
+        }
+        Out += TEXT("]}");
+    }
+}
+
+//////// HISTOGRAMME ////////
+FQTEHistogram::FQTEHistogram(float InBucketWidth)
+    : BucketWidth(InBucketWidth)
+{
+    for (uint32& Bucket : Buckets)
+    {
+        Bucket = 0;
+    }
+}
+
+void FQTEHistogram::Add(double Value)
+{
+    const int32 Bucket = FMath::Clamp(FMath::FloorToInt32(Value / BucketWidth), 0, NumBuckets);
+    ++Buckets[Bucket];
+
+    const float SampleValue = static_cast<float>(Value);
+    Min = Count > 0 ? FMath::Min(Min, SampleValue) : SampleValue;
+    Max = Count > 0 ? FMath::Max(Max, SampleValue) : SampleValue;
+    Sum += Value;
+    ++Count;
+}
+
+float FQTEHistogram::GetPercentile(float Percentile) const
+{
+    if (Count == 0)
+    {
+        return 0.0f;
+    }
+
+    const uint32 Target = FMath::Max(1u, static_cast<uint32>(FMath::CeilToInt32(Percentile * Count)));
+    uint32 Cumulated = 0;
+
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        Cumulated += Buckets[Bucket];
+        if (Cumulated >= Target)
+        {
+            return FMath::Min((Bucket + 1) * BucketWidth, Max);
+        }
+    }
+
+    // Seau de dépassement : seule la valeur maximale est connue
+    return Max;
+}
+
+//////// TELEMETRIE ////////
+FQTEConfigurationTelemetry::FQTEConfigurationTelemetry()
+{
+    for (uint32& Count : Failures)
+    {
+        Count = 0;
+    }
+}
+
+int32 FQTETelemetry::FindOrAddConfiguration(const FString& ConfigurationName)
+{
+    if (const int32* Index = ConfigurationIndices.Find(ConfigurationName))
+    {
+        return *Index;
+    }
+
+    const int32 Index = Configurations.AddDefaulted();
+    Configurations[Index].ConfigurationName = ConfigurationName;
+    ConfigurationIndices.Add(ConfigurationName, Index);
+    return Index;
+}
+
+void FQTETelemetry::Reset()
+{
+    Configurations.Reset();
+    ConfigurationIndices.Reset();
+}
+
+FString FQTETelemetry::ExportCSV() const
+{
+    FString Out = TEXT("Configuration,Scope,Metric,Count,Mean,Min,Max,P50,P90,BucketWidth,Buckets\n");
+
+    for (const FQTEConfigurationTelemetry& Configuration : Configurations)
+    {
+        const FString& Name = Configuration.ConfigurationName;
+        const FString SessionScope = TEXT("Session");
+
+        AppendCounterCSV(Out, Name, SessionScope, TEXT("Sessions"), Configuration.NumSessions);
+        AppendCounterCSV(Out, Name, SessionScope, TEXT("Successes"), Configuration.NumSuccesses);
+        for (int32 Cause = 1; Cause < QTEFailureCauseCount; ++Cause)
+        {
+            AppendCounterCSV(Out, Name, SessionScope, TEXT("Failure") + GetFailureCauseName(Cause), Configuration.Failures[Cause]);
+        }
+        AppendHistogramCSV(Out, Name, SessionScope, TEXT("Duration"), Configuration.Duration);
+
+        for (int32 Slot = 0; Slot < QTESnapPointTypeCount; ++Slot)
+        {
+            const FQTESnapPointTelemetry& SnapPoint = Configuration.SnapPoints[Slot];
+            if (SnapPoint.FirstInput.Count == 0 && SnapPoint.NumCompletions == 0)
+            {
+                continue;
+            }
+
+            const FString Scope = GetSnapPointName(Slot);
+            AppendCounterCSV(Out, Name, Scope, TEXT("Presses"), SnapPoint.NumPresses);
+            AppendCounterCSV(Out, Name, Scope, TEXT("Completions"), SnapPoint.NumCompletions);
+            AppendHistogramCSV(Out, Name, Scope, TEXT("FirstInput"), SnapPoint.FirstInput);
+            AppendHistogramCSV(Out, Name, Scope, TEXT("InterPress"), SnapPoint.InterPress);
+            AppendHistogramCSV(Out, Name, Scope, TEXT("Completion"), SnapPoint.Completion);
+        }
+    }
+    return Out;
+}
+
+FString FQTETelemetry::ExportJSON() const
+{
+    FString Out = TEXT("{\"configurations\":[");
+
+    for (int32 Index = 0; Index < Configurations.Num(); ++Index)
+    {
+        const FQTEConfigurationTelemetry& Configuration = Configurations[Index];
+        Out += FString::Printf(TEXT("%s{\"name\":\"%s\",\"sessions\":%u,\"successes\":%u,\"failures\":{"),
+            Index > 0 ? TEXT(",") : TEXT(""), *Configuration.ConfigurationName.ReplaceCharWithEscapedChar(),
+            Configuration.NumSessions, Configuration.NumSuccesses);
+
+        for (int32 Cause = 1; Cause < QTEFailureCauseCount; ++Cause)
+        {
+            Out += FString::Printf(TEXT("%s\"%s\":%u"), Cause > 1 ? TEXT(",") : TEXT(""), *GetFailureCauseName(Cause), Configuration.Failures[Cause]);
+        }
+        Out += TEXT("},");
+        AppendHistogramJSON(Out, TEXT("duration"), Configuration.Duration);
+        Out += TEXT(",\"snapPoints\":[");
+
+        bool bFirstSnapPoint = true;
+        for (int32 Slot = 0; Slot < QTESnapPointTypeCount; ++Slot)
+        {
+            const FQTESnapPointTelemetry& SnapPoint = Configuration.SnapPoints[Slot];
+            if (SnapPoint.FirstInput.Count == 0 && SnapPoint.NumCompletions == 0)
+            {
+                continue;
+            }
+
+            Out += FString::Printf(TEXT("%s{\"snapPoint\":\"%s\",\"presses\":%u,\"completions\":%u,"),
+                bFirstSnapPoint ? TEXT("") : TEXT(","), *GetSnapPointName(Slot), SnapPoint.NumPresses, SnapPoint.NumCompletions);
+            AppendHistogramJSON(Out, TEXT("firstInput"), SnapPoint.FirstInput);
+            Out += TEXT(",");
+            AppendHistogramJSON(Out, TEXT("interPress"), SnapPoint.InterPress);
+            Out += TEXT(",");
+            AppendHistogramJSON(Out, TEXT("completion"), SnapPoint.Completion);
+            Out += TEXT("}");
+            bFirstSnapPoint = false;
+        }
+        Out += TEXT("]}");
+    }
+
+    Out += TEXT("]}\n");
+    return Out;
+}
+
+bool FQTETelemetry::ExportToFile(EQTETelemetryFormat Format, const FString& Path) const
+{
+    const FString Content = Format == EQTETelemetryFormat::JSON ? ExportJSON() : ExportCSV();
+    return FFileHelper::SaveStringToFile(Content, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
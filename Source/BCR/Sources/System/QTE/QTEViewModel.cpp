@@ -0,0 +1,30 @@
+﻿#include "BCR/Headers/System/QTE/QTEViewModel.h"
+
+UQTEViewModel::UQTEViewModel()
+{
+    SnapPoints.SetNum(QTESnapPointTypeCount);
+}
+
+void UQTEViewModel::Reset(FQTESessionHandle InSession, const FString& InConfigurationName)
+{
+    Session = InSession;
+    ConfigurationName = InConfigurationName;
+    State = EQTEState::WaitingForPlayers;
+    StageName = NAME_None;
+    RemainingTime = -1.0f;
+
+    for (FQTESnapPointView& View : SnapPoints)
+    {
+        View = FQTESnapPointView();
+    }
+    bIsDirty = true;
+}
+
+void UQTEViewModel::FlushUpdates()
+{
+    if (bIsDirty)
+    {
+        bIsDirty = false;
+        OnUpdated.Broadcast();
+    }
+}
@@ -2,48 +2,256 @@
 #include "BCR/Headers/System/QTE/QTE_Subsystem.h"
 #include "BCR/Headers/Player/MainPlayer.h"
 #include "BCR/Headers/Interfaces/BCR_Helper.h"
+#include "BCR/Headers/Interfaces/QTEWidgetInterface.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameInstance.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+#include "Misc/Paths.h"
+
+DECLARE_STATS_GROUP(TEXT("QTE"), STATGROUP_QTE, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Progress Updates"), STAT_QTEProgressUpdates, STATGROUP_QTE);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Progress Broadcasts"), STAT_QTEProgressBroadcasts, STATGROUP_QTE);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Result Updates"), STAT_QTEResultUpdates, STATGROUP_QTE);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Result Broadcasts"), STAT_QTEResultBroadcasts, STATGROUP_QTE);
+
+static TAutoConsoleVariable<bool> CVarQTELogActions(
+    TEXT("QTE.LogActions"),
+    true,
+    TEXT("Affiche un log console et écran à chaque action QTE validée"));
+
+static TAutoConsoleVariable<float> CVarQTEProgressThreshold(
+    TEXT("QTE.ProgressThreshold"),
+    0.05f,
+    TEXT("Variation minimale de progression (ou de position du stick) avant de republier OnQTEActionProgress"));
+
+static TAutoConsoleVariable<bool> CVarQTERecord(
+    TEXT("QTE.Record"),
+    false,
+    TEXT("Enregistre les inputs validés de chaque session dans Saved/QTE (rejouables avec QTE.Replay)"));
+
+static TAutoConsoleVariable<bool> CVarQTECoalesceEvents(
+    TEXT("QTE.CoalesceEvents"),
+    true,
+    TEXT("Ne publie progression et résultats que sur changement (0 = diffusion à chaque tick, pour comparaison)"));
+
+static TAutoConsoleVariable<bool> CVarQTETelemetry(
+    TEXT("QTE.Telemetry"),
+    true,
+    TEXT("Mesure les sessions QTE (temps de réaction, intervalles entre appuis, causes d'échec, durées)"));
+
+static TAutoConsoleVariable<int32> CVarQTETelemetryExport(
+    TEXT("QTE.TelemetryExport"),
+    0,
+    TEXT("Exporte la télémétrie dans Saved/QTE à la fin de chaque session : 0 = non, 1 = CSV, 2 = JSON"));
+
+static FAutoConsoleCommandWithWorldAndArgs QTEExportTelemetryCommand(
+    TEXT("QTE.ExportTelemetry"),
+    TEXT("QTE.ExportTelemetry [csv|json] : exporte la télémétrie cumulée des sessions dans Saved/QTE"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        if (UQTE_Subsystem* QTESystem = GameInstance ? GameInstance->GetSubsystem<UQTE_Subsystem>() : nullptr)
+        {
+            const bool bJson = Args.Num() > 0 && Args[0].Equals(TEXT("json"), ESearchCase::IgnoreCase);
+            QTESystem->ExportTelemetry(bJson ? EQTETelemetryFormat::JSON : EQTETelemetryFormat::CSV);
+        }
+    }));
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs QTEBenchmarkCommand(
+    TEXT("QTE.Benchmark"),
+    TEXT("QTE.Benchmark [Sessions=256] [Frames=600] : mesure le coût par frame de la mise à jour groupée des sessions"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        if (UQTE_Subsystem* QTESystem = GameInstance ? GameInstance->GetSubsystem<UQTE_Subsystem>() : nullptr)
+        {
+            const int32 NumSessions = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 256;
+            const int32 NumFrames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 600;
+            QTESystem->RunBenchmark(FMath::Max(1, NumSessions), FMath::Max(1, NumFrames));
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs QTEPreloadReportCommand(
+    TEXT("QTE.PreloadReport"),
+    TEXT("QTE.PreloadReport : liste les assets QTE préchargés, leur taille estimée et leur durée de chargement"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        if (const UQTE_Subsystem* QTESystem = GameInstance ? GameInstance->GetSubsystem<UQTE_Subsystem>() : nullptr)
+        {
+            QTESystem->GetPreloader().LogReport();
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs QTEReplayCommand(
+    TEXT("QTE.Replay"),
+    TEXT("QTE.Replay <Fichier> [Runs=1] : rejoue un enregistrement (chemin relatif à Saved/QTE) et vérifie son résultat"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        UQTE_Subsystem* QTESystem = GameInstance ? GameInstance->GetSubsystem<UQTE_Subsystem>() : nullptr;
+        if (QTESystem && Args.Num() > 0)
+        {
+            const int32 NumRuns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+            QTESystem->RunReplay(Args[0], FMath::Max(1, NumRuns));
+        }
+    }));
+#endif
+
+// Échantillonne l'état du contrôleur d'un joueur pour un snap point
+static FQTEInputSample SamplePlayerInput(const AMainPlayer* Player, const FSnapPointConfig& Config)
+{
+    FQTEInputSample Sample;
+
+    if (auto PC = Player->GetController<APlayerController>())
+    {
+        if (Config.ActionType == EQTEActionType::Rotate)
+        {
+            float X = 0.0f, Y = 0.0f;
+            PC->GetInputAnalogStickState(EControllerAnalogStick::CAS_LeftStick, X, Y);
+            Sample.StickPosition = FVector2D(X, Y);
+        }
+        else if (Config.ActionType != EQTEActionType::None)
+        {
+            Sample.bIsDown = PC->IsInputKeyDown(Config.RequiredInput);
+            Sample.bJustPressed = PC->WasInputKeyJustPressed(Config.RequiredInput);
+            Sample.bJustReleased = PC->WasInputKeyJustReleased(Config.RequiredInput);
+        }
+    }
+    return Sample;
+}
 
 void UQTE_Subsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
-    ResetState();
-    CurrentState = EQTEState::Inactive;
+
+    TelemetryFileName = FString::Printf(TEXT("Telemetry_%s"), *FDateTime::Now().ToString());
 }
 
 void UQTE_Subsystem::Deinitialize()
 {
-    StopQTE();
+    StopAllQTE();
+    StopInputCapture();
+    InputProcessor.Reset();
+
+    for (TPair<TObjectPtr<UClass>, FQTEWidgetPoolEntry>& Pool : FreeWidgets)
+    {
+        for (UUserWidget* Widget : Pool.Value.Widgets)
+        {
+            Widget->RemoveFromParent();
+        }
+    }
+    FreeWidgets.Reset();
+    FreeViewModels.Reset();
+
     Super::Deinitialize();
 }
 
-void UQTE_Subsystem::StartQTEFromAsset(const UQTEConfigurationAsset* Config)
+void UQTE_Subsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
 {
-    if (!Config)
+    // Les sessions ne sont pas des UPROPERTY : leurs widgets sont déclarés ici
+    UQTE_Subsystem* This = CastChecked<UQTE_Subsystem>(InThis);
+    for (int32 Index = 0; Index < This->Sessions.Num(); ++Index)
     {
-        IBCR_Helper::LogAll(this, TEXT("StartQTEFromAsset: Invalid Config Asset"), 5.0f, FColor::Red);
+        FQTESession& Session = This->Sessions[Index];
+        Collector.AddReferencedObject(Session.Widget);
+        Collector.AddReferencedObject(Session.ViewModel);
+    }
+
+    Super::AddReferencedObjects(InThis, Collector);
+}
+
+void UQTE_Subsystem::Tick(float DeltaTime)
+{
+    FrameRealTime = FPlatformTime::Seconds();
+    FrameDeltaTime = DeltaTime;
+
+    const UWorld* World = GetWorld();
+    const AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr;
+    FrameTimeDilation = WorldSettings ? WorldSettings->GetEffectiveTimeDilation() : 1.0;
+
+    // Seules les sessions non suspendues avancent
+    for (int32 Index = 0; Index < Sessions.Num(); ++Index)
+    {
+        FQTESession& Session = Sessions[Index];
+        if (Session.State == EQTEState::Running || Session.State == EQTEState::WaitingForPlayers)
+        {
+            Session.Clock += DeltaTime;
+        }
     }
 
-    if (IsQTERunning())
+    ProcessQueuedInputs();
+    ProcessInputs();
+
+    for (int32 Index = 0; Index < Sessions.Num(); ++Index)
     {
-        return;
+        CheckDeadlines(Index);
+        FlushViewModel(Sessions[Index]);
+    }
+}
+
+ETickableTickType UQTE_Subsystem::GetTickableTickType() const
+{
+    // Le CDO ne tick jamais ; l'instance seulement tant qu'une session est active
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UQTE_Subsystem::IsTickable() const
+{
+    return GetActiveSessionCount() > 0;
+}
+
+UWorld* UQTE_Subsystem::GetTickableGameObjectWorld() const
+{
+    return GetWorld();
+}
+
+TStatId UQTE_Subsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UQTE_Subsystem, STATGROUP_Tickables);
+}
+
+FQTESessionHandle UQTE_Subsystem::StartQTEFromAsset(const UQTEConfigurationAsset* Config)
+{
+    if (!Config)
+    {
+        IBCR_Helper::LogAll(this, TEXT("StartQTEFromAsset: Invalid Config Asset"), 5.0f, FColor::Red);
+        return FQTESessionHandle();
     }
-    
-    StartQTE(Config->ToRuntimeConfig());
+
+    return StartQTEProgram(Config->GetProgram());
+}
+
+FQTESessionHandle UQTE_Subsystem::StartQTE(const FQTEConfiguration Config)
+{
+    return StartQTEProgram(FQTEProgram::Compile(Config));
 }
 
-void UQTE_Subsystem::StartQTE(const FQTEConfiguration Config)
+FQTESessionHandle UQTE_Subsystem::StartQTEProgram(const TSharedRef<const FQTEProgram>& Program)
 {
-    if (IsQTERunning())
+    if (!Program->IsValid())
     {
-        return;
+        return FQTESessionHandle();
+    }
+
+    const FQTESessionHandle Handle = AllocateSession();
+    FQTESession& Session = Sessions[Handle.Index];
+    Session.Program = Program;
+
+    if (CVarQTERecord.GetValueOnGameThread())
+    {
+        Session.Recording = MakeShared<FQTERecording>();
+        Session.Recording->Configuration = Program->MakeConfiguration();
+        Session.Recording->StartTime = Session.Clock;
     }
 
-    CurrentConfig = Config;
-    ActionProgress.Empty();
-    
-    if (!IsQTEConfigValid())
+    if (CVarQTETelemetry.GetValueOnGameThread())
     {
-        return;
+        Session.TelemetryIndex = Telemetry.FindOrAddConfiguration(Program->GetConfigurationName());
     }
 
     ////////////////////////////////////////////////
@@ -56,366 +264,1475 @@ void UQTE_Subsystem::StartQTE(const FQTEConfiguration Config)
         GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, TEXT("Get ready!"));
     }
     ////////////////////////////////////////////////
-    
-    SetQTEState(EQTEState::WaitingForPlayers);
-    
-    if (CurrentConfig.TotalTime > 0.0f)
+
+    Session.State = EQTEState::WaitingForPlayers;
+
+    // Le temps total court dès l'attente des joueurs
+    if (Session.Program->GetTotalTime() > 0.0f)
+    {
+        Session.Deadline = Session.Clock + Session.Program->GetTotalTime();
+    }
+
+    AcquireWidget(Handle.Index);
+
+    return Handle;
+}
+
+void UQTE_Subsystem::OnPlayerEnterSnapPoint(FQTESessionHandle Handle, AMainPlayer* Player, ESnapPointType SnapPoint)
+{
+    if (!Player)
     {
-        SetupTimers();
+        return;
     }
+
+    RegisterParticipant(Handle, Player, GetPlayerUserIndex(Player), SnapPoint);
 }
 
-void UQTE_Subsystem::OnPlayerEnterSnapPoint(AMainPlayer* Player, ESnapPointType SnapPoint)
+void UQTE_Subsystem::OnUserEnterSnapPoint(FQTESessionHandle Handle, int32 UserIndex, ESnapPointType SnapPoint)
 {
-    if (!Player || CurrentState != EQTEState::WaitingForPlayers)
+    RegisterParticipant(Handle, nullptr, UserIndex, SnapPoint);
+}
+
+void UQTE_Subsystem::RegisterParticipant(FQTESessionHandle Handle, AMainPlayer* Player, int32 UserIndex, ESnapPointType SnapPoint)
+{
+    FQTESession* Session = FindSession(Handle);
+    if (!Session || Session->State != EQTEState::WaitingForPlayers || !Session->Program->IsParticipant(SnapPoint))
     {
         return;
     }
 
-    ActivePlayers.Add(SnapPoint, Player);
+    const int32 Slot = static_cast<int32>(SnapPoint);
+    FQTESnapPointState& State = Session->SnapPoints[Slot];
+
+    if (State.bIsOccupied)
+    {
+        UserRoutes.RemoveSingle(State.UserIndex, FQTEUserRoute{ Handle.Index, SnapPoint });
+    }
+    else
+    {
+        ++Session->NumOccupied;
+    }
+
+    State.Player = Player;
+    State.UserIndex = UserIndex;
+    State.bIsOccupied = true;
+    UserRoutes.Add(UserIndex, FQTEUserRoute{ Handle.Index, SnapPoint });
 
     ////////////////////////////////////////////////
     // Log technical details
-    IBCR_Helper::LogConsole(this, 
-        FString::Printf(TEXT("Player registered at %s"), 
+    IBCR_Helper::LogConsole(this,
+        FString::Printf(TEXT("Player registered at %s"),
         *UEnum::GetValueAsString(SnapPoint)));
 
     // visual log for demonstration
-    
     if (GEngine)
     {
-        FString PlayerText = (SnapPoint == ESnapPointType::First) ? TEXT("Player 1") : TEXT("Player 2");
+        FString PlayerText = FString::Printf(TEXT("Player %d"), Slot + 1);
         GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Cyan,
             FString::Printf(TEXT("%s ready"), *PlayerText));
-        
-        if (ActivePlayers.Num() == 2)
+
+        if (CanStartQTE(*Session))
         {
             GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, TEXT("Play the QTE !"));
-            
-            SetQTEState(EQTEState::Running);
-        
-            if (UWorld* World = GetWorld())
-            {
-                World->GetTimerManager().SetTimer(ProcessTimerHandle, 
-                    [this]() 
-                    { 
-                        if (GetWorld())
-                        {
-                            ProcessInputs(GetWorld()->GetDeltaSeconds()); 
-                        }
-                    },
-                    0.016f,
-                    true);
-            }
         }
     }
+    ////////////////////////////////////////////////
+
+    if (CanStartQTE(*Session))
+    {
+        Session->State = EQTEState::Running;
+        Session->RunStartTime = Session->Clock;
+        EnterStage(Handle.Index, 0, Session->Clock);
+        if (Session->Recording.IsValid())
+        {
+            Session->Recording->StartTime = Session->StartTime;
+        }
+        UpdateSharedProcessing();
+    }
 }
 
-void UQTE_Subsystem::OnPlayerLeaveSnapPoint(AMainPlayer* Player, ESnapPointType SnapPoint)
+void UQTE_Subsystem::OnPlayerLeaveSnapPoint(FQTESessionHandle Handle, AMainPlayer* Player, ESnapPointType SnapPoint)
 {
-    if (!Player)
+    if (!Player || !FindSession(Handle))
     {
         return;
     }
 
-    ActivePlayers.Remove(SnapPoint);
-    CompleteQTE(false);
+    CompleteQTE(Handle.Index, false, EQTEFailureCause::PlayerLeft);
 }
 
-void UQTE_Subsystem::ProcessInputs(float DeltaTime)
+void UQTE_Subsystem::UpdateSharedProcessing()
 {
-    if (CurrentState != EQTEState::Running || bIsPaused)
+    // Le tick traite toutes les sessions ; seule la capture Slate dépend des modes utilisés
+    bool bAnyEvents = false;
+
+    for (int32 Index = 0; Index < Sessions.Num() && !bAnyEvents; ++Index)
     {
-        return;
+        const FQTESession& Session = Sessions[Index];
+        bAnyEvents = Session.HasStarted() && Session.Program->GetInputMode() == EQTEInputMode::Events;
+    }
+
+    if (bAnyEvents)
+    {
+        StartInputCapture();
     }
-    
-    for (const auto& PlayerPair : ActivePlayers)
+    else
     {
-        ESnapPointType SnapPoint = PlayerPair.Key;
-        AMainPlayer* Player = PlayerPair.Value.Get();
-        
-        if (!Player)
+        StopInputCapture();
+    }
+}
+
+void UQTE_Subsystem::ProcessInputs()
+{
+    // Mise à jour groupée de toutes les sessions en mode Polling
+    for (int32 Index = 0; Index < Sessions.Num(); ++Index)
+    {
+        const FQTESession& Session = Sessions[Index];
+        if (Session.State != EQTEState::Running || Session.Program->GetInputMode() != EQTEInputMode::Polling)
         {
-            IBCR_Helper::LogAll(this, TEXT("Invalid player reference!"), 1.0f, FColor::Red);
             continue;
         }
-        
-        if (const FSnapPointConfig* Config = CurrentConfig.SnapPoints.FindByPredicate(
-            [SnapPoint](const FSnapPointConfig& Cfg) { return Cfg.SnapPointType == SnapPoint; }))
-        {
-            ProcessPlayerInput(Player, SnapPoint, *Config, DeltaTime);
-        }
-        else
+
+        // Référence locale : un callback peut terminer la session pendant le parcours
+        const TSharedRef<const FQTEProgram> Program = Session.Program.ToSharedRef();
+        const FQTECompiledStage& Stage = Program->GetStage(Session.Stage);
+        const int32 StageSerial = Session.StageSerial;
+
+        const double Now = Session.Clock;
+
+        for (ESnapPointType SnapPoint : Stage.GetUsedSnapPoints())
         {
-            IBCR_Helper::LogAll(this, TEXT("No config found for snap point!"), 1.0f, FColor::Red);
+            AMainPlayer* Player = Session.SnapPoints[static_cast<int32>(SnapPoint)].Player.Get();
+
+            if (!Player)
+            {
+                IBCR_Helper::LogAll(this, TEXT("Invalid player reference!"), 1.0f, FColor::Red);
+                continue;
+            }
+
+            const FQTECompiledSnapPoint& SnapPointProgram = *Stage.GetSnapPoint(SnapPoint);
+            ProcessPlayerInput(Index, SnapPoint, SnapPointProgram, SamplePlayerInput(Player, SnapPointProgram.Config), Now);
+
+            // La nouvelle étape sera traitée au prochain tick
+            if (Session.State != EQTEState::Running || Session.StageSerial != StageSerial)
+            {
+                break;
+            }
         }
     }
 }
 
-void UQTE_Subsystem::ProcessPlayerInput(AMainPlayer* Player, ESnapPointType SnapPoint, const FSnapPointConfig& Config, float DeltaTime)
+void UQTE_Subsystem::ProcessPlayerInput(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, const FQTEInputSample& Sample, double Now)
 {
-    if (CurrentState != EQTEState::Running)
+    const FSnapPointConfig& Config = SnapPointProgram.Config;
+
+    FQTESession& Session = Sessions[SessionIndex];
+    if (Session.State != EQTEState::Running)
+    {
+        return;
+    }
+
+    FQTESnapPointState& State = Session.SnapPoints[static_cast<int32>(SnapPoint)];
+    if (State.Progress.bIsComplete)
     {
         return;
     }
-    
-    FQTEProgressData* Progress = ActionProgress.Find(SnapPoint);
-    if (Progress && Progress->bIsComplete)
+    const int32 StageSerial = Session.StageSerial;
+
+    // Un échantillon au repos ne change rien, sauf pour interrompre une rotation ou un maintien suivis
+    if (!Sample.IsIdle() || State.Stick.IsTracking() || State.Progress.bIsHeld)
+    {
+        FQTERecordEntry Entry;
+        Entry.Type = EQTERecordEntryType::Sample;
+        Entry.SnapPoint = SnapPoint;
+        Entry.Sample = Sample;
+        RecordEntry(SessionIndex, MoveTemp(Entry), Now);
+    }
+
+    if (!Sample.IsIdle())
+    {
+        TrackInput(SessionIndex, SnapPoint, Sample.bJustPressed, Now);
+    }
+
+    FQTEInputSample Measured = Sample;
+    Measured.Time = Now;
+    if (Config.ActionType == EQTEActionType::Rotate)
+    {
+        State.Stick.AddReading(Sample.StickPosition, Now);
+        Measured.AngularVelocity = State.Stick.GetAngularVelocity();
+        Measured.Revolutions = State.Stick.GetRevolutions();
+        Measured.Direction = State.Stick.GetDirection();
+    }
+
+    int32 Successes = SnapPointProgram.PollValidator(Measured, Config, State.Progress);
+
+    // Jugé à l'instant du tick : moins précis que l'horodatage du mode événementiel
+    if (SnapPointProgram.IsTimed())
+    {
+        if (Successes > 0)
+        {
+            Successes = JudgeInput(SessionIndex, SnapPoint, SnapPointProgram, Now) ? 1 : 0;
+        }
+        else
+        {
+            ExpireCues(SessionIndex, SnapPoint, SnapPointProgram, Now);
+        }
+
+        if (Session.State != EQTEState::Running || Session.StageSerial != StageSerial)
+        {
+            return;
+        }
+    }
+
+    // Un Hold reste réussi tant qu'il est maintenu, entre deux crédits
+    PublishSnapPointResult(SessionIndex, SnapPoint, Successes > 0 || State.Progress.bIsHeld);
+
+    if (Successes > 0 && ApplyActionSuccess(SessionIndex, SnapPoint, Config, Successes, Now))
     {
         return;
     }
-    
-    bool bSuccess = ValidatePlayerAction(Player, Config);
+    UpdateActionProgress(SessionIndex, SnapPoint, Config, Measured);
+}
 
-    switch (SnapPoint)
+bool UQTE_Subsystem::ApplyActionSuccess(int32 SessionIndex, ESnapPointType SnapPoint, const FSnapPointConfig& Config, int32 Count, double Now)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    if (Session.State != EQTEState::Running)
     {
-    case ESnapPointType::First:
-        OnSnapPointFirstResult.Broadcast(bSuccess);
-        break;
-    case ESnapPointType::Second:
-        OnSnapPointSecondResult.Broadcast(bSuccess);
-        break;
+        return true;
     }
-    
-    if (bSuccess)
+
+    FQTEProgressData& NewProgress = Session.SnapPoints[static_cast<int32>(SnapPoint)].Progress;
+    NewProgress.SuccessCount += Count;
+
+    if (FQTESnapPointView* View = FindSnapPointView(SessionIndex, SnapPoint))
     {
-        FQTEProgressData& NewProgress = ActionProgress.FindOrAdd(SnapPoint);
-        NewProgress.SuccessCount++;
+        View->SuccessCount = NewProgress.SuccessCount;
+    }
 
+    if (CVarQTELogActions.GetValueOnGameThread())
+    {
         ////////////////////////////////////////////////
         // Log technical details
-        IBCR_Helper::LogConsole(this, 
-            FString::Printf(TEXT("Action validated for %s"), 
+        IBCR_Helper::LogConsole(this,
+            FString::Printf(TEXT("Action validated for %s"),
             *UEnum::GetValueAsString(SnapPoint)));
 
         // visual log for demonstration
         if (GEngine)
         {
-            FString PlayerText = (SnapPoint == ESnapPointType::First) ? TEXT("Player 1") : TEXT("Player 2");
+            FString PlayerText = FString::Printf(TEXT("Player %d"), static_cast<int32>(SnapPoint) + 1);
             GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green,
                 FString::Printf(TEXT("%s: Success!"), *PlayerText));
         }
         ////////////////////////////////////////////////
-        
-        if (NewProgress.SuccessCount >= Config.RepeatCount)
-        {
-            NewProgress.bIsComplete = true;
-        }
-        
-        if (CheckQTECompletion())
+    }
+
+    if (!NewProgress.bIsComplete && NewProgress.SuccessCount >= Config.RepeatCount)
+    {
+        NewProgress.bIsComplete = true;
+        ++Session.NumCompleted;
+
+        if (Session.TelemetryIndex != INDEX_NONE)
         {
-            CompleteQTE(true);
-            return;
+            FQTESnapPointTelemetry& SnapPointTelemetry = Telemetry.GetConfiguration(Session.TelemetryIndex).SnapPoints[static_cast<int32>(SnapPoint)];
+            ++SnapPointTelemetry.NumCompletions;
+            SnapPointTelemetry.Completion.Add(Now - Session.StartTime);
         }
     }
-    UpdateActionProgress(Player, SnapPoint, Config);
-}
 
-bool UQTE_Subsystem::ValidatePlayerAction(AMainPlayer* Player, const FSnapPointConfig& Config)
-{
-    bool result = false;
-    
-    switch (Config.ActionType)
+    if (CheckStageCompletion(Session))
     {
-    case EQTEActionType::Press:
-        result = ValidatePressAction(Player, Config);
-        break;
-    case EQTEActionType::Hold:
-        result = ValidateHoldAction(Player, Config);
-        break;
-    case EQTEActionType::Release:
-        result = ValidateReleaseAction(Player, Config);
-        break;
-    case EQTEActionType::Rotate:
-        result = ValidateRotateAction(Player, Config);
-        break;
+        EndStage(SessionIndex, true, Now, EQTEFailureCause::None);
+        return true;
     }
-    return result;
+    return false;
 }
 
-bool UQTE_Subsystem::ValidateHoldAction(const AMainPlayer* Player, const FSnapPointConfig& Config)
+void UQTE_Subsystem::PublishSnapPointResult(int32 SessionIndex, ESnapPointType SnapPoint, bool bSuccess)
 {
-    if (auto PC = Player->GetController<APlayerController>())
+    INC_DWORD_STAT(STAT_QTEResultUpdates);
+
+    FQTESnapPointState& State = Sessions[SessionIndex].SnapPoints[static_cast<int32>(SnapPoint)];
+    if (State.bLastResult == bSuccess && CVarQTECoalesceEvents.GetValueOnGameThread())
     {
-        return PC->IsInputKeyDown(Config.RequiredInput);
+        return;
     }
-    return false;
-}
+    State.bLastResult = bSuccess;
 
-bool UQTE_Subsystem::ValidateRotateAction(const AMainPlayer* Player, const FSnapPointConfig& Config)
-{
-    if (auto PC = Player->GetController<APlayerController>())
+    if (FQTESnapPointView* View = FindSnapPointView(SessionIndex, SnapPoint))
     {
-        float X = 0.0f, Y = 0.0f;
-        PC->GetInputAnalogStickState(EControllerAnalogStick::CAS_LeftStick, X, Y);
-        float RotationSpeed = FVector2D(X, Y).Size();
-        return RotationSpeed >= Config.MinRotationSpeed;
+        View->bLastResult = bSuccess;
     }
-    return false;
+
+    INC_DWORD_STAT(STAT_QTEResultBroadcasts);
+    const FQTESessionHandle Handle = MakeHandle(SessionIndex);
+    Sessions[SessionIndex].Delegates.OnSnapPointResult.Broadcast(Handle, SnapPoint, bSuccess);
+    OnSnapPointResult.Broadcast(Handle, SnapPoint, bSuccess);
 }
 
-bool UQTE_Subsystem::ValidatePressAction(const AMainPlayer* Player, const FSnapPointConfig& Config)
+void UQTE_Subsystem::PublishActionProgress(int32 SessionIndex, ESnapPointType SnapPoint, const FQTEActionProgress& Progress)
 {
-    if (auto PC = Player->GetController<APlayerController>())
+    INC_DWORD_STAT(STAT_QTEProgressUpdates);
+
+    FQTESnapPointState& State = Sessions[SessionIndex].SnapPoints[static_cast<int32>(SnapPoint)];
+    State.LatestProgress = Progress;
+
+    if (!HasProgressChanged(State, Progress))
     {
-        bool bWasPressed = PC->WasInputKeyJustPressed(Config.RequiredInput);
-        return bWasPressed;
+        return;
     }
-    return false;
+    State.PublishedProgress = Progress;
+    State.bHasPublishedProgress = true;
+
+    if (FQTESnapPointView* View = FindSnapPointView(SessionIndex, SnapPoint))
+    {
+        View->Progress = Progress;
+    }
+
+    INC_DWORD_STAT(STAT_QTEProgressBroadcasts);
+    const FQTESessionHandle Handle = MakeHandle(SessionIndex);
+    Sessions[SessionIndex].Delegates.OnActionProgress.Broadcast(Handle, SnapPoint, Progress);
+    OnQTEActionProgress.Broadcast(Handle, SnapPoint, Progress);
 }
 
-bool UQTE_Subsystem::ValidateReleaseAction(const AMainPlayer* Player, const FSnapPointConfig& Config)
+bool UQTE_Subsystem::HasProgressChanged(const FQTESnapPointState& State, const FQTEActionProgress& Progress) const
 {
-    if (auto PC = Player->GetController<APlayerController>())
+    if (!State.bHasPublishedProgress || !CVarQTECoalesceEvents.GetValueOnGameThread())
     {
-        return PC->WasInputKeyJustReleased(Config.RequiredInput);
+        return true;
     }
-    return false;
+
+    const FQTEActionProgress& Published = State.PublishedProgress;
+    const float Threshold = CVarQTEProgressThreshold.GetValueOnGameThread();
+
+    // Les changements d'état ou de sens et les extrémités (0 ou 1) sont toujours publiés
+    return Progress.bIsActive != Published.bIsActive
+        || Progress.Direction != Published.Direction
+        || (Progress.Progress != Published.Progress && (Progress.Progress <= 0.0f || Progress.Progress >= 1.0f))
+        || FMath::Abs(Progress.Progress - Published.Progress) >= Threshold
+        || FVector2D::DistSquared(Progress.StickPosition, Published.StickPosition) >= FMath::Square(Threshold);
 }
 
-void UQTE_Subsystem::UpdateActionProgress(const AMainPlayer* Player, ESnapPointType SnapPoint, const FSnapPointConfig& Config)
+bool UQTE_Subsystem::GetActionProgressSnapshot(FQTESessionHandle Handle, ESnapPointType SnapPoint, FQTEActionProgress& OutProgress) const
 {
-    FQTEActionProgress Progress;
-
-    if (auto PC = Player->GetController<APlayerController>())
+    const FQTESession* Session = FindSession(Handle);
+    if (!Session || !Session->IsRunning())
     {
-        switch (Config.ActionType)
-        {
-            case EQTEActionType::Rotate:
-            {
-                float X = 0.0f, Y = 0.0f;
-                PC->GetInputAnalogStickState(EControllerAnalogStick::CAS_LeftStick, X, Y);
-                Progress.StickPosition = FVector2D(X, Y);
-                Progress.Progress = Progress.StickPosition.Size() / Config.MinRotationSpeed;
-                Progress.bIsActive = Progress.Progress > 0.0f;
-                break;
-            }
-            case EQTEActionType::Hold:
-            case EQTEActionType::Press:
-            case EQTEActionType::Release:
-            {
-                Progress.bIsActive = PC->IsInputKeyDown(Config.RequiredInput);
-                Progress.Progress = Progress.bIsActive ? 1.0f : 0.0f;
-                break;
-            }
-            case EQTEActionType::None:
-            default:
-            {
-                break;
-            }
-        }
+        return false;
     }
 
-    OnQTEActionProgress.Broadcast(SnapPoint, Progress);
+    OutProgress = Session->SnapPoints[static_cast<int32>(SnapPoint)].LatestProgress;
+    return true;
 }
 
-void UQTE_Subsystem::StopQTE()
+void UQTE_Subsystem::QueueInputEvent(const FQTEInputEvent& Event)
 {
-    if (!IsQTERunning())
+    if (GetActiveSessionCount() == 0)
     {
         return;
     }
 
-    ClearTimers();
-    ResetState();
-    SetQTEState(EQTEState::Inactive);
-    OnQTEComplete.Broadcast(false);
+    PendingInputs.Add(Event);
 }
 
-void UQTE_Subsystem::SetQTEPaused(bool bPause)
+void UQTE_Subsystem::ProcessQueuedInputs()
 {
-    if (bPause == bIsPaused || !IsQTERunning())
+    // La validation peut terminer des sessions : on traite une copie stable de la file
+    Swap(PendingInputs, ProcessingInputs);
+    for (const FQTEInputEvent& Event : ProcessingInputs)
     {
-        return;
+        ProcessInputEvent(Event);
     }
+    ProcessingInputs.Reset();
 
-    bIsPaused = bPause;
-    
-    if (UWorld* World = GetWorld())
+    // Hold maintenus, Rotate analogiques et repères dépassés sont suivis à chaque tick
+    for (int32 Index = 0; Index < Sessions.Num(); ++Index)
     {
-        if (bPause)
-        {
-            World->GetTimerManager().PauseTimer(ProcessTimerHandle);
-            World->GetTimerManager().PauseTimer(GlobalTimerHandle);
-        }
-        else
+        const FQTESession& Session = Sessions[Index];
+        if (Session.State == EQTEState::Running && Session.Program->GetInputMode() == EQTEInputMode::Events)
         {
-            World->GetTimerManager().UnPauseTimer(ProcessTimerHandle);
-            World->GetTimerManager().UnPauseTimer(GlobalTimerHandle);
+            UpdateHeldActions(Index, Session.Clock);
         }
     }
 }
 
-bool UQTE_Subsystem::IsQTERunning() const
+void UQTE_Subsystem::ProcessInputEvent(const FQTEInputEvent& Event)
 {
-    return CurrentState == EQTEState::Running || CurrentState == EQTEState::WaitingForPlayers;
-}
+    TArray<FQTEUserRoute, TInlineAllocator<4>> Routes;
+    UserRoutes.MultiFind(Event.UserIndex, Routes);
 
-bool UQTE_Subsystem::IsQTEConfigValid() const
-{
-    return CurrentConfig.SnapPoints.Num() > 0 && CurrentConfig.SnapPoints.Num() <= 2;
+    for (const FQTEUserRoute& Route : Routes)
+    {
+        FQTEInputEvent SessionEvent = Event;
+        SessionEvent.Timestamp = ToSessionTime(Sessions[Route.SessionIndex], Event.Timestamp);
+        ProcessSnapPointEvent(Route.SessionIndex, Route.SnapPoint, SessionEvent);
+    }
 }
 
-bool UQTE_Subsystem::CanStartQTE() const
+double UQTE_Subsystem::ToSessionTime(const FQTESession& Session, double Timestamp) const
 {
-    return ActivePlayers.Num() == CurrentConfig.SnapPoints.Num();
+    // L'événement date de la frame écoulée : l'horloge de session est reculée de son âge (dilaté), borné à la frame
+    return Session.Clock - FMath::Clamp((FrameRealTime - Timestamp) * FrameTimeDilation, 0.0, FrameDeltaTime);
 }
 
-bool UQTE_Subsystem::CheckQTECompletion()
+void UQTE_Subsystem::ProcessSnapPointEvent(int32 SessionIndex, ESnapPointType SnapPoint, const FQTEInputEvent& Event)
 {
-    bool allComplete = true;
-    
-    for (const auto& Config : CurrentConfig.SnapPoints)
+    FQTESession& Session = Sessions[SessionIndex];
+    if (Session.State != EQTEState::Running || Session.Program->GetInputMode() != EQTEInputMode::Events)
+    {
+        return;
+    }
+
+    const FQTECompiledSnapPoint* SnapPointProgram = Session.Program->GetStage(Session.Stage).GetSnapPoint(SnapPoint);
+    if (!SnapPointProgram)
+    {
+        return;
+    }
+    const int32 StageSerial = Session.StageSerial;
+
+    // Les axes du stick ne font que mettre à jour la lecture, mesurée à chaque mise à jour
+    if (Event.Type == EQTEInputEventType::Axis)
     {
-        const FQTEProgressData* Progress = ActionProgress.Find(Config.SnapPointType);
-        if (!Progress || !Progress->bIsComplete)
+        if (SnapPointProgram->Config.ActionType == EQTEActionType::Rotate)
         {
-            allComplete = false;
+            FVector2D& Reading = Session.SnapPoints[static_cast<int32>(SnapPoint)].StickReading;
+            (Event.Key == EKeys::Gamepad_LeftX ? Reading.X : Reading.Y) = Event.AxisValue;
         }
+        return;
     }
-    
-    return allComplete;
-}
 
-void UQTE_Subsystem::SetupTimers()
-{
-    if (UWorld* World = GetWorld())
+    if (SnapPointProgram->Config.RequiredInput != Event.Key)
     {
-        World->GetTimerManager().SetTimer(GlobalTimerHandle,
-            [this]() { CompleteQTE(false); },
-            CurrentConfig.TotalTime,
-            false);
+        return;
     }
-}
 
-void UQTE_Subsystem::ClearTimers()
-{
-    if (UWorld* World = GetWorld())
+    FQTEProgressData& Progress = Session.SnapPoints[static_cast<int32>(SnapPoint)].Progress;
+    if (Progress.bIsComplete)
     {
-        World->GetTimerManager().ClearTimer(GlobalTimerHandle);
-        World->GetTimerManager().ClearTimer(ProcessTimerHandle);
+        return;
     }
-}
 
-void UQTE_Subsystem::ResetState()
-{
-    CurrentConfig = FQTEConfiguration();
-    ActivePlayers.Empty();
-    bIsPaused = false;
-}
+    FQTERecordEntry Entry;
+    Entry.Type = EQTERecordEntryType::Event;
+    Entry.SnapPoint = SnapPoint;
+    Entry.EventType = Event.Type;
+    RecordEntry(SessionIndex, MoveTemp(Entry), Event.Timestamp);
 
-void UQTE_Subsystem::SetQTEState(EQTEState NewState)
-{
-    if (CurrentState != NewState)
+    const bool bPressed = Event.Type == EQTEInputEventType::Pressed;
+    TrackInput(SessionIndex, SnapPoint, bPressed, Event.Timestamp);
+    int32 Successes = SnapPointProgram->EventValidator(Event, Progress);
+
+    // Jugé sur l'horodatage de l'événement : indépendant des à-coups de frame
+    if (Successes > 0 && SnapPointProgram->IsTimed())
     {
-        CurrentState = NewState;
+        Successes = JudgeInput(SessionIndex, SnapPoint, *SnapPointProgram, Event.Timestamp) ? 1 : 0;
+        if (Session.State != EQTEState::Running || Session.StageSerial != StageSerial)
+        {
+            return;
+        }
     }
-}
 
-void UQTE_Subsystem::CompleteQTE(bool bSuccess)
-{
-    ClearTimers();
-    
-    SetQTEState(bSuccess ? EQTEState::Completed : EQTEState::Failed);
-    OnQTEComplete.Broadcast(bSuccess);
-}
\ No newline at end of file
+    PublishSnapPointResult(SessionIndex, SnapPoint, Successes > 0);
+
+    if (Successes > 0 && ApplyActionSuccess(SessionIndex, SnapPoint, SnapPointProgram->Config, Successes, Event.Timestamp))
+    {
+        return;
+    }
+
+    FQTEActionProgress ActionState;
+    ActionState.bIsActive = bPressed;
+    ActionState.Progress = bPressed ? 1.0f : 0.0f;
+    PublishActionProgress(SessionIndex, SnapPoint, ActionState);
+}
+
+void UQTE_Subsystem::UpdateHeldActions(int32 SessionIndex, double Now)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+
+    // Référence locale : un callback peut terminer la session pendant le parcours
+    const TSharedRef<const FQTEProgram> Program = Session.Program.ToSharedRef();
+    const FQTECompiledStage& Stage = Program->GetStage(Session.Stage);
+    const int32 StageSerial = Session.StageSerial;
+
+    for (ESnapPointType SnapPoint : Stage.GetUsedSnapPoints())
+    {
+        const FQTECompiledSnapPoint& SnapPointProgram = *Stage.GetSnapPoint(SnapPoint);
+        FQTESnapPointState& State = Session.SnapPoints[static_cast<int32>(SnapPoint)];
+
+        if (!State.bIsOccupied)
+        {
+            continue;
+        }
+
+        // Les repères dépassés sans input sont manqués (après traitement des événements en file)
+        if (SnapPointProgram.IsTimed())
+        {
+            if (!State.Progress.bIsComplete && ExpireCues(SessionIndex, SnapPoint, SnapPointProgram, Now))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // Le stick est mesuré à chaque mise à jour depuis la dernière lecture reçue par événements
+        if (SnapPointProgram.Config.ActionType == EQTEActionType::Rotate)
+        {
+            FQTEInputSample Sample;
+            Sample.StickPosition = State.StickReading;
+            ProcessPlayerInput(SessionIndex, SnapPoint, SnapPointProgram, Sample, Now);
+        }
+        else
+        {
+            const FQTEProgressData& Progress = State.Progress;
+            if (!Progress.bIsHeld || Progress.bIsComplete)
+            {
+                continue;
+            }
+
+            if (CreditHeldAction(SessionIndex, SnapPoint, SnapPointProgram, Now))
+            {
+                return;
+            }
+        }
+
+        // Étape changée : la nouvelle étape est traitée à la prochaine mise à jour
+        if (Session.State != EQTEState::Running || Session.StageSerial != StageSerial)
+        {
+            return;
+        }
+    }
+}
+
+bool UQTE_Subsystem::CreditHeldAction(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, double Now)
+{
+    FQTEProgressData& Progress = Sessions[SessionIndex].SnapPoints[static_cast<int32>(SnapPoint)].Progress;
+
+    const int32 Successes = FMath::FloorToInt32((Now - Progress.HoldStartTime) / ProcessInterval) - Progress.HoldCredited;
+    if (Successes <= 0)
+    {
+        return false;
+    }
+
+    FQTERecordEntry Entry;
+    Entry.Type = EQTERecordEntryType::HoldUpdate;
+    Entry.SnapPoint = SnapPoint;
+    RecordEntry(SessionIndex, MoveTemp(Entry), Now);
+
+    Progress.HoldCredited += Successes;
+    PublishSnapPointResult(SessionIndex, SnapPoint, true);
+    return ApplyActionSuccess(SessionIndex, SnapPoint, SnapPointProgram.Config, Successes, Now);
+}
+
+bool UQTE_Subsystem::JudgeInput(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, double Time)
+{
+    // Les repères dépassés avant cet input sont manqués avant de le juger
+    if (ExpireCues(SessionIndex, SnapPoint, SnapPointProgram, Time))
+    {
+        return false;
+    }
+
+    const FQTESession& Session = Sessions[SessionIndex];
+    FQTEProgressData& Progress = Sessions[SessionIndex].SnapPoints[static_cast<int32>(SnapPoint)].Progress;
+    if (!SnapPointProgram.Cues.IsValidIndex(Progress.CueCursor))
+    {
+        return false;
+    }
+
+    const FSnapPointConfig& Config = SnapPointProgram.Config;
+    const double Offset = (Time - Session.StartTime) - SnapPointProgram.Cues[Progress.CueCursor];
+
+    // Input trop tôt pour le prochain repère : jugé Miss sans consommer le repère
+    if (FMath::Abs(Offset) > Config.GoodWindow)
+    {
+        PublishJudgement(SessionIndex, SnapPoint, EQTEJudgement::Miss, Offset);
+        return false;
+    }
+
+    const EQTEJudgement Judgement = FMath::Abs(Offset) <= Config.PerfectWindow ? EQTEJudgement::Perfect : EQTEJudgement::Good;
+    ++(Judgement == EQTEJudgement::Perfect ? Progress.PerfectCount : Progress.GoodCount);
+    ++Progress.CueCursor;
+
+    PublishJudgement(SessionIndex, SnapPoint, Judgement, Offset);
+    return Sessions[SessionIndex].State == EQTEState::Running;
+}
+
+bool UQTE_Subsystem::ExpireCues(int32 SessionIndex, ESnapPointType SnapPoint, const FQTECompiledSnapPoint& SnapPointProgram, double Time)
+{
+    const FQTESession& Session = Sessions[SessionIndex];
+    FQTEProgressData& Progress = Sessions[SessionIndex].SnapPoints[static_cast<int32>(SnapPoint)].Progress;
+
+    const FSnapPointConfig& Config = SnapPointProgram.Config;
+    const TArray<double>& Cues = SnapPointProgram.Cues;
+    const double SessionTime = Time - Session.StartTime;
+    bool bMissed = false;
+
+    // Le curseur n'avance que sur les repères dont la fenêtre est close
+    while (Cues.IsValidIndex(Progress.CueCursor) && SessionTime > Cues[Progress.CueCursor] + Config.GoodWindow)
+    {
+        // Verdict tiré de l'horloge du tick : enregistré pour que le rejeu le rende au même instant
+        if (!bMissed)
+        {
+            FQTERecordEntry Entry;
+            Entry.Type = EQTERecordEntryType::CueExpiry;
+            Entry.SnapPoint = SnapPoint;
+            RecordEntry(SessionIndex, MoveTemp(Entry), Time);
+        }
+
+        const double Offset = SessionTime - Cues[Progress.CueCursor];
+        ++Progress.CueCursor;
+        ++Progress.MissCount;
+        bMissed = true;
+
+        PublishJudgement(SessionIndex, SnapPoint, EQTEJudgement::Miss, Offset);
+        if (Session.State != EQTEState::Running)
+        {
+            return true;
+        }
+    }
+
+    // Plus assez de repères restants pour atteindre RepeatCount : échec immédiat de l'étape
+    if (bMissed && !Progress.bIsComplete && Progress.SuccessCount + (Cues.Num() - Progress.CueCursor) < Config.RepeatCount)
+    {
+        EndStage(SessionIndex, false, Time, EQTEFailureCause::MissedCues);
+        return true;
+    }
+    return false;
+}
+
+void UQTE_Subsystem::PublishJudgement(int32 SessionIndex, ESnapPointType SnapPoint, EQTEJudgement Judgement, double Offset)
+{
+    if (FQTESnapPointView* View = FindSnapPointView(SessionIndex, SnapPoint))
+    {
+        View->LastJudgement = Judgement;
+        View->bHasJudgement = true;
+    }
+
+    const FQTESessionHandle Handle = MakeHandle(SessionIndex);
+    Sessions[SessionIndex].Delegates.OnJudgement.Broadcast(Handle, SnapPoint, Judgement, Offset);
+    OnQTEJudgement.Broadcast(Handle, SnapPoint, Judgement, Offset);
+}
+
+void UQTE_Subsystem::StartInputCapture()
+{
+    if (!InputProcessor.IsValid())
+    {
+        InputProcessor = MakeShared<FQTEInputProcessor>(
+            FOnQTEInputEvent::CreateUObject(this, &UQTE_Subsystem::QueueInputEvent));
+    }
+
+    // Sans Slate (ex: -nullrhi), seuls les inputs injectés via QueueInputEvent sont reçus
+    if (FSlateApplication::IsInitialized())
+    {
+        FSlateApplication::Get().RegisterInputPreProcessor(InputProcessor);
+    }
+}
+
+void UQTE_Subsystem::StopInputCapture()
+{
+    if (InputProcessor.IsValid() && FSlateApplication::IsInitialized())
+    {
+        FSlateApplication::Get().UnregisterInputPreProcessor(InputProcessor);
+    }
+    PendingInputs.Reset();
+}
+
+int32 UQTE_Subsystem::GetPlayerUserIndex(const AMainPlayer* Player) const
+{
+    if (const APlayerController* PC = Player->GetController<APlayerController>())
+    {
+        if (const ULocalPlayer* LocalPlayer = PC->GetLocalPlayer())
+        {
+            return LocalPlayer->GetControllerId();
+        }
+    }
+    return INDEX_NONE;
+}
+
+void UQTE_Subsystem::UpdateActionProgress(int32 SessionIndex, ESnapPointType SnapPoint, const FSnapPointConfig& Config, const FQTEInputSample& Sample)
+{
+    FQTEActionProgress Progress;
+
+    switch (Config.ActionType)
+    {
+        case EQTEActionType::Rotate:
+        {
+            Progress.StickPosition = Sample.StickPosition;
+            Progress.Revolutions = Sample.Revolutions;
+            Progress.Direction = Sample.Direction;
+            Progress.Progress = Config.MinRotationSpeed > 0.0f
+                ? FMath::Abs(Sample.AngularVelocity) / Config.MinRotationSpeed
+                : 1.0f;
+            Progress.bIsActive = Sample.AngularVelocity != 0.0f;
+            break;
+        }
+        case EQTEActionType::Hold:
+        case EQTEActionType::Press:
+        case EQTEActionType::Release:
+        {
+            Progress.bIsActive = Sample.bIsDown;
+            Progress.Progress = Progress.bIsActive ? 1.0f : 0.0f;
+            break;
+        }
+        case EQTEActionType::None:
+        default:
+        {
+            break;
+        }
+    }
+
+    PublishActionProgress(SessionIndex, SnapPoint, Progress);
+}
+
+void UQTE_Subsystem::StopQTE(FQTESessionHandle Handle)
+{
+    FQTESession* Session = FindSession(Handle);
+    if (!Session || !Session->IsRunning())
+    {
+        return;
+    }
+
+    FinishRecording(Handle.Index, false);
+    RecordSessionTelemetry(*Session, EQTEFailureCause::Stopped);
+    FQTESessionDelegates Delegates = MoveTemp(Session->Delegates);
+    ReleaseSession(Handle.Index);
+    UpdateSharedProcessing();
+
+    Delegates.OnComplete.Broadcast(Handle, false);
+    OnQTEComplete.Broadcast(Handle, false);
+}
+
+void UQTE_Subsystem::StopAllQTE()
+{
+    for (int32 Index = 0; Index < Sessions.Num(); ++Index)
+    {
+        if (Sessions[Index].State != EQTEState::Inactive)
+        {
+            StopQTE(MakeHandle(Index));
+        }
+    }
+}
+
+void UQTE_Subsystem::SetQTEPaused(FQTESessionHandle Handle, bool bPause)
+{
+    FQTESession* Session = FindSession(Handle);
+    if (!Session || !Session->IsRunning() || bPause == (Session->State == EQTEState::Paused))
+    {
+        return;
+    }
+
+    // L'horloge de session ne tourne pas en pause : repères et échéances sont suspendus sans décalage
+    if (bPause)
+    {
+        Session->ResumeState = Session->State;
+        Session->State = EQTEState::Paused;
+    }
+    else
+    {
+        Session->State = Session->ResumeState;
+        Session->ResumeState = EQTEState::Inactive;
+    }
+
+    RefreshViewModel(Handle.Index);
+}
+
+FQTESessionDelegates* UQTE_Subsystem::GetSessionDelegates(FQTESessionHandle Handle)
+{
+    FQTESession* Session = FindSession(Handle);
+    return Session ? &Session->Delegates : nullptr;
+}
+
+EQTEState UQTE_Subsystem::GetSessionState(FQTESessionHandle Handle) const
+{
+    const FQTESession* Session = FindSession(Handle);
+    return Session ? Session->State : EQTEState::Inactive;
+}
+
+bool UQTE_Subsystem::IsSessionRunning(FQTESessionHandle Handle) const
+{
+    const FQTESession* Session = FindSession(Handle);
+    return Session && Session->IsRunning();
+}
+
+float UQTE_Subsystem::GetSessionTime(FQTESessionHandle Handle) const
+{
+    const FQTESession* Session = FindSession(Handle);
+    if (!Session || !Session->HasStarted())
+    {
+        return -1.0f;
+    }
+
+    return static_cast<float>(Session->Clock - Session->StartTime);
+}
+
+UUserWidget* UQTE_Subsystem::GetSessionWidget(FQTESessionHandle Handle) const
+{
+    const FQTESession* Session = FindSession(Handle);
+    return Session ? Session->Widget.Get() : nullptr;
+}
+
+UQTEViewModel* UQTE_Subsystem::GetSessionViewModel(FQTESessionHandle Handle) const
+{
+    const FQTESession* Session = FindSession(Handle);
+    return Session ? Session->ViewModel.Get() : nullptr;
+}
+
+FName UQTE_Subsystem::GetSessionStage(FQTESessionHandle Handle) const
+{
+    const FQTESession* Session = FindSession(Handle);
+    if (!Session || !Session->HasStarted())
+    {
+        return NAME_None;
+    }
+    return Session->Program->GetStage(Session->Stage).Name;
+}
+
+FQTESession* UQTE_Subsystem::FindSession(FQTESessionHandle Handle)
+{
+    if (Handle.Index < 0 || Handle.Index >= Sessions.Num())
+    {
+        return nullptr;
+    }
+
+    FQTESession& Session = Sessions[Handle.Index];
+    return (Session.Serial == Handle.Serial && Session.State != EQTEState::Inactive) ? &Session : nullptr;
+}
+
+const FQTESession* UQTE_Subsystem::FindSession(FQTESessionHandle Handle) const
+{
+    return const_cast<UQTE_Subsystem*>(this)->FindSession(Handle);
+}
+
+FQTESessionHandle UQTE_Subsystem::AllocateSession()
+{
+    int32 Index = INDEX_NONE;
+
+    if (FreeSlots.Num() > 0)
+    {
+        Index = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Index = Sessions.Add(1);
+    }
+
+    return MakeHandle(Index);
+}
+
+void UQTE_Subsystem::ReleaseSession(int32 Index)
+{
+    FQTESession& Session = Sessions[Index];
+    ReleaseWidget(Session);
+
+    for (int32 Slot = 0; Slot < QTESnapPointTypeCount; ++Slot)
+    {
+        FQTESnapPointState& State = Session.SnapPoints[Slot];
+        if (State.bIsOccupied)
+        {
+            UserRoutes.RemoveSingle(State.UserIndex, FQTEUserRoute{ Index, static_cast<ESnapPointType>(Slot) });
+        }
+        State = FQTESnapPointState();
+    }
+
+    // Vide le slot en conservant la mémoire des conteneurs pour la prochaine session
+    Session.State = EQTEState::Inactive;
+    Session.ResumeState = EQTEState::Inactive;
+    Session.Program.Reset();
+    Session.NumOccupied = 0;
+    Session.Stage = 0;
+    Session.StageSerial = 0;
+    Session.NumCompleted = 0;
+    Session.Clock = 0.0;
+    Session.RunStartTime = 0.0;
+    Session.StartTime = 0.0;
+    Session.Deadline = -1.0;
+    Session.StageDeadline = -1.0;
+    Session.Delegates = FQTESessionDelegates();
+    Session.Recording.Reset();
+    Session.TelemetryIndex = INDEX_NONE;
+    ++Session.Serial;
+
+    FreeSlots.Add(Index);
+}
+
+FQTESessionHandle UQTE_Subsystem::MakeHandle(int32 Index) const
+{
+    FQTESessionHandle Handle;
+    Handle.Index = Index;
+    Handle.Serial = Sessions[Index].Serial;
+    return Handle;
+}
+
+bool UQTE_Subsystem::CanStartQTE(const FQTESession& Session) const
+{
+    return Session.NumOccupied == Session.Program->GetNumParticipants();
+}
+
+bool UQTE_Subsystem::CheckStageCompletion(const FQTESession& Session) const
+{
+    return Session.NumCompleted == Session.Program->GetStage(Session.Stage).GetNumSnapPoints();
+}
+
+void UQTE_Subsystem::CheckDeadlines(int32 SessionIndex)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+
+    // L'étape échoue à l'instant exact de son échéance, quelle que soit la durée de la frame
+    if (Session.State == EQTEState::Running && Session.StageDeadline >= 0.0 && Session.Clock >= Session.StageDeadline)
+    {
+        EndStage(SessionIndex, false, Session.StageDeadline, EQTEFailureCause::StageTimeout);
+    }
+
+    if ((Session.State == EQTEState::Running || Session.State == EQTEState::WaitingForPlayers)
+        && Session.Deadline >= 0.0 && Session.Clock >= Session.Deadline)
+    {
+        CompleteQTE(SessionIndex, false, EQTEFailureCause::Timeout);
+    }
+}
+
+void UQTE_Subsystem::EnterStage(int32 SessionIndex, int32 Stage, double Now)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    Session.Stage = Stage;
+    ++Session.StageSerial;
+    Session.NumCompleted = 0;
+    Session.StartTime = Now;
+
+    // Les participants restent, la progression repart de zéro (aucune allocation)
+    for (FQTESnapPointState& State : Session.SnapPoints)
+    {
+        State.Progress = FQTEProgressData();
+        State.Stick.Reset();
+        State.bHasPublishedProgress = false;
+    }
+
+    // En rejeu, les dépassements sont lus dans le flux
+    const float TimeLimit = Session.Program->GetStage(Stage).TimeLimit;
+    const bool bIsReplay = Session.Recording.IsValid() && Session.Recording->bIsReplay;
+    Session.StageDeadline = (TimeLimit > 0.0f && !bIsReplay) ? Now + TimeLimit : -1.0;
+
+    RefreshViewModel(SessionIndex);
+}
+
+void UQTE_Subsystem::EndStage(int32 SessionIndex, bool bSuccess, double Now, EQTEFailureCause Cause)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    const int32 Next = Session.Program->GetTransition(Session.Stage, bSuccess);
+
+    // Chaque transition de la table laisse une trace, quel que soit le chemin qui l'a déclenchée
+    FQTERecordEntry Entry;
+    Entry.Type = EQTERecordEntryType::StageEnd;
+    Entry.StageSerial = Session.StageSerial;
+    Entry.bStageSucceeded = bSuccess;
+    Entry.Cause = Cause;
+    RecordEntry(SessionIndex, MoveTemp(Entry), Now);
+
+    if (Next < 0)
+    {
+        CompleteQTE(SessionIndex, Next == QTEStageComplete, Cause);
+        return;
+    }
+
+    EnterStage(SessionIndex, Next, Now);
+
+    const FQTESessionHandle Handle = MakeHandle(SessionIndex);
+    const FName StageName = Session.Program->GetStage(Next).Name;
+
+    ////////////////////////////////////////////////
+    // Log technical details
+    IBCR_Helper::LogConsole(this,
+        FString::Printf(TEXT("QTE stage %s -> %s"),
+        bSuccess ? TEXT("succeeded") : TEXT("failed"), *StageName.ToString()));
+    ////////////////////////////////////////////////
+
+    Session.Delegates.OnStageChanged.Broadcast(Handle, Next, StageName, bSuccess);
+    OnQTEStageChanged.Broadcast(Handle, Next, StageName, bSuccess);
+}
+
+void UQTE_Subsystem::CompleteQTE(int32 SessionIndex, bool bSuccess, EQTEFailureCause Cause)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    const FQTESessionHandle Handle = MakeHandle(SessionIndex);
+
+    FinishRecording(SessionIndex, bSuccess);
+    RecordSessionTelemetry(Session, bSuccess ? EQTEFailureCause::None : Cause);
+
+    // Dernier état diffusé au widget avant son retour au pool
+    if (Session.ViewModel)
+    {
+        Session.ViewModel->State = bSuccess ? EQTEState::Completed : EQTEState::Failed;
+        Session.ViewModel->MarkDirty();
+        Session.ViewModel->FlushUpdates();
+    }
+
+    // Le slot est libéré avant la diffusion : un callback peut démarrer une nouvelle session
+    FQTESessionDelegates Delegates = MoveTemp(Session.Delegates);
+    ReleaseSession(SessionIndex);
+    UpdateSharedProcessing();
+
+    Delegates.OnComplete.Broadcast(Handle, bSuccess);
+    OnQTEComplete.Broadcast(Handle, bSuccess);
+}
+
+void UQTE_Subsystem::AcquireWidget(int32 SessionIndex)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    const TSoftClassPtr<UUserWidget>& SoftClass = Session.Program->GetWidgetClass();
+    if (SoftClass.IsNull())
+    {
+        return;
+    }
+
+    // Classe non préchargée : le widget apparaîtra à la fin du chargement
+    UClass* WidgetClass = SoftClass.Get();
+    if (!WidgetClass)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("QTE: widget %s not preloaded, streaming it"), *SoftClass.ToString());
+        Session.WidgetLoadHandle = Preloader.LoadAsync(SoftClass.ToSoftObjectPath(),
+            FStreamableDelegate::CreateUObject(this, &UQTE_Subsystem::OnWidgetClassLoaded, MakeHandle(SessionIndex)));
+        return;
+    }
+
+    FQTEWidgetPoolEntry* Pool = FreeWidgets.Find(WidgetClass);
+    if (Pool && Pool->Widgets.Num() > 0)
+    {
+        Session.Widget = Pool->Widgets.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Session.Widget = CreateWidget<UUserWidget>(GetGameInstance(), WidgetClass);
+        if (!Session.Widget)
+        {
+            return;
+        }
+    }
+
+    Session.ViewModel = FreeViewModels.Num() > 0 ? FreeViewModels.Pop(EAllowShrinking::No) : NewObject<UQTEViewModel>(this);
+    Session.ViewModel->Reset(MakeHandle(SessionIndex), Session.Program->GetConfigurationName());
+    RefreshViewModel(SessionIndex);
+
+    // Un widget rendu au pool reste dans le viewport, replié
+    if (!Session.Widget->IsInViewport())
+    {
+        Session.Widget->AddToViewport();
+    }
+    Session.Widget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+
+    if (Session.Widget->Implements<UQTEWidgetInterface>())
+    {
+        IQTEWidgetInterface::Execute_BindViewModel(Session.Widget, Session.ViewModel);
+    }
+}
+
+void UQTE_Subsystem::OnWidgetClassLoaded(FQTESessionHandle Handle)
+{
+    FQTESession* Session = FindSession(Handle);
+    if (Session && !Session->Widget)
+    {
+        Session->WidgetLoadHandle.Reset();
+        AcquireWidget(Handle.Index);
+    }
+}
+
+void UQTE_Subsystem::ReleaseWidget(FQTESession& Session)
+{
+    if (Session.WidgetLoadHandle.IsValid())
+    {
+        Session.WidgetLoadHandle->CancelHandle();
+        Session.WidgetLoadHandle.Reset();
+    }
+
+    if (Session.Widget)
+    {
+        if (Session.Widget->Implements<UQTEWidgetInterface>())
+        {
+            IQTEWidgetInterface::Execute_UnbindViewModel(Session.Widget);
+        }
+        Session.Widget->SetVisibility(ESlateVisibility::Collapsed);
+        FreeWidgets.FindOrAdd(Session.Widget->GetClass()).Widgets.Add(Session.Widget);
+        Session.Widget = nullptr;
+    }
+
+    if (Session.ViewModel)
+    {
+        Session.ViewModel->OnUpdated.Clear();
+        FreeViewModels.Add(Session.ViewModel);
+        Session.ViewModel = nullptr;
+    }
+}
+
+void UQTE_Subsystem::RefreshViewModel(int32 SessionIndex)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    UQTEViewModel* ViewModel = Session.ViewModel;
+    if (!ViewModel)
+    {
+        return;
+    }
+
+    ViewModel->State = Session.State;
+    ViewModel->StageName = Session.HasStarted() ? Session.Program->GetStage(Session.Stage).Name : NAME_None;
+
+    for (int32 Slot = 0; Slot < QTESnapPointTypeCount; ++Slot)
+    {
+        const ESnapPointType SnapPoint = static_cast<ESnapPointType>(Slot);
+        const FQTECompiledSnapPoint* Compiled = Session.HasStarted() ? Session.Program->GetStage(Session.Stage).GetSnapPoint(SnapPoint) : nullptr;
+        const FQTESnapPointState& State = Session.SnapPoints[Slot];
+
+        FQTESnapPointView& View = ViewModel->GetSnapPointView(SnapPoint);
+        View.bIsUsed = Compiled != nullptr;
+        View.RequiredCount = Compiled ? Compiled->Config.RepeatCount : 0;
+        View.SuccessCount = State.Progress.SuccessCount;
+        View.Progress = State.LatestProgress;
+    }
+    ViewModel->MarkDirty();
+}
+
+void UQTE_Subsystem::FlushViewModel(FQTESession& Session)
+{
+    UQTEViewModel* ViewModel = Session.ViewModel;
+    if (!ViewModel)
+    {
+        return;
+    }
+
+    // Échéance la plus proche entre l'étape et le QTE
+    double Remaining = -1.0;
+    if (Session.StageDeadline >= 0.0)
+    {
+        Remaining = Session.StageDeadline - Session.Clock;
+    }
+    if (Session.Deadline >= 0.0 && (Remaining < 0.0 || Session.Deadline - Session.Clock < Remaining))
+    {
+        Remaining = Session.Deadline - Session.Clock;
+    }
+    ViewModel->RemainingTime = Remaining >= 0.0 ? static_cast<float>(Remaining) : -1.0f;
+
+    ViewModel->FlushUpdates();
+}
+
+FQTESnapPointView* UQTE_Subsystem::FindSnapPointView(int32 SessionIndex, ESnapPointType SnapPoint)
+{
+    UQTEViewModel* ViewModel = Sessions[SessionIndex].ViewModel;
+    if (!ViewModel)
+    {
+        return nullptr;
+    }
+    ViewModel->MarkDirty();
+    return &ViewModel->GetSnapPointView(SnapPoint);
+}
+
+void UQTE_Subsystem::RecordEntry(int32 SessionIndex, FQTERecordEntry&& Entry, double Now)
+{
+    if (FQTERecording* Recording = Sessions[SessionIndex].Recording.Get())
+    {
+        Recording->AddEntry(MoveTemp(Entry), Now);
+    }
+}
+
+void UQTE_Subsystem::FinishRecording(int32 SessionIndex, bool bSuccess)
+{
+    FQTESession& Session = Sessions[SessionIndex];
+    FQTERecording* Recording = Session.Recording.Get();
+    if (!Recording)
+    {
+        return;
+    }
+
+    Recording->bSuccess = bSuccess;
+    for (int32 Slot = 0; Slot < QTESnapPointTypeCount; ++Slot)
+    {
+        Recording->SuccessCounts[Slot] = Session.SnapPoints[Slot].Progress.SuccessCount;
+    }
+
+    if (Recording->bIsReplay)
+    {
+        return;
+    }
+
+    OnRecordingFinished.Broadcast(*Recording);
+
+    // Plusieurs machines peuvent finir la même seconde avec la même config : l'emplacement et son numéro distinguent les fichiers
+    const FString Path = FQTERecording::GetRecordingDirectory() / FString::Printf(TEXT("%s_%s_%d-%d.qterec"),
+        *FPaths::MakeValidFileName(Recording->Configuration.ConfigurationName), *FDateTime::Now().ToString(), SessionIndex, Session.Serial);
+
+    if (Recording->SaveToFile(Path))
+    {
+        IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE recording saved: %s"), *Path));
+    }
+    else
+    {
+        IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE recording could not be saved: %s"), *Path));
+    }
+}
+
+void UQTE_Subsystem::TrackInput(int32 SessionIndex, ESnapPointType SnapPoint, bool bPressed, double Now)
+{
+    const FQTESession& Session = Sessions[SessionIndex];
+    if (Session.TelemetryIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    FQTESnapPointState& State = Sessions[SessionIndex].SnapPoints[static_cast<int32>(SnapPoint)];
+    FQTESnapPointTelemetry& SnapPointTelemetry = Telemetry.GetConfiguration(Session.TelemetryIndex).SnapPoints[static_cast<int32>(SnapPoint)];
+
+    if (!State.bHasInput)
+    {
+        State.bHasInput = true;
+        SnapPointTelemetry.FirstInput.Add(Now - Session.RunStartTime);
+    }
+
+    if (bPressed)
+    {
+        if (State.LastPressTime >= 0.0)
+        {
+            SnapPointTelemetry.InterPress.Add(Now - State.LastPressTime);
+        }
+        State.LastPressTime = Now;
+        ++SnapPointTelemetry.NumPresses;
+    }
+}
+
+void UQTE_Subsystem::RecordSessionTelemetry(const FQTESession& Session, EQTEFailureCause Cause)
+{
+    if (Session.TelemetryIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    FQTEConfigurationTelemetry& ConfigurationTelemetry = Telemetry.GetConfiguration(Session.TelemetryIndex);
+    ++ConfigurationTelemetry.NumSessions;
+    ++(Cause == EQTEFailureCause::None ? ConfigurationTelemetry.NumSuccesses : ConfigurationTelemetry.Failures[static_cast<int32>(Cause)]);
+    ConfigurationTelemetry.Duration.Add(Session.Clock);
+
+    switch (CVarQTETelemetryExport.GetValueOnGameThread())
+    {
+        case 1:
+            ExportTelemetry(EQTETelemetryFormat::CSV);
+            break;
+        case 2:
+            ExportTelemetry(EQTETelemetryFormat::JSON);
+            break;
+        default:
+            break;
+    }
+}
+
+bool UQTE_Subsystem::ExportTelemetry(EQTETelemetryFormat Format)
+{
+    const FString Path = FQTERecording::GetRecordingDirectory() / TelemetryFileName
+        + (Format == EQTETelemetryFormat::JSON ? TEXT(".json") : TEXT(".csv"));
+
+    if (!Telemetry.ExportToFile(Format, Path))
+    {
+        IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE telemetry could not be saved: %s"), *Path));
+        return false;
+    }
+
+    IBCR_Helper::LogConsole(this, FString::Printf(TEXT("QTE telemetry saved: %s"), *Path));
+    return true;
+}
+
+bool UQTE_Subsystem::ReplayRecording(const FQTERecording& Recording, FQTERecording& OutResult)
+{
+    // Index utilisateur hors de la plage des manettes réelles et du benchmark
+    constexpr int32 FirstReplayUser = 2000;
+
+    const TSharedRef<const FQTEProgram> Program = FQTEProgram::Compile(Recording.Configuration);
+    const FQTESessionHandle Handle = StartQTEProgram(Program);
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+
+    // Temps simulé : le timeout est rejoué par la fin du flux, pas par l'échéance ; hors télémétrie
+    Sessions[Handle.Index].Deadline = -1.0;
+    Sessions[Handle.Index].TelemetryIndex = INDEX_NONE;
+
+    const TSharedRef<FQTERecording> Replayed = MakeShared<FQTERecording>();
+    Replayed->Configuration = Recording.Configuration;
+    Replayed->bIsReplay = true;
+    Sessions[Handle.Index].Recording = Replayed;
+
+    for (ESnapPointType SnapPoint : Program->GetParticipants())
+    {
+        OnUserEnterSnapPoint(Handle, FirstReplayUser + static_cast<int32>(SnapPoint), SnapPoint);
+    }
+
+    // Les horodatages enregistrés partent du passage en Running
+    Sessions[Handle.Index].StartTime = 0.0;
+    Replayed->StartTime = 0.0;
+
+    for (const FQTERecordEntry& Entry : Recording.Entries)
+    {
+        if (!FindSession(Handle))
+        {
+            break;
+        }
+
+        // Étape déjà terminée par les entrées précédentes : rien à forcer
+        if (Entry.Type == EQTERecordEntryType::StageEnd)
+        {
+            if (Sessions[Handle.Index].StageSerial == Entry.StageSerial)
+            {
+                EndStage(Handle.Index, Entry.bStageSucceeded, Entry.Time, Entry.Cause);
+            }
+            continue;
+        }
+
+        const FQTECompiledSnapPoint* SnapPointProgram = Program->GetStage(Sessions[Handle.Index].Stage).GetSnapPoint(Entry.SnapPoint);
+        if (!SnapPointProgram)
+        {
+            continue;
+        }
+
+        switch (Entry.Type)
+        {
+        case EQTERecordEntryType::Sample:
+            ProcessPlayerInput(Handle.Index, Entry.SnapPoint, *SnapPointProgram, Entry.Sample, Entry.Time);
+            break;
+        case EQTERecordEntryType::Event:
+        {
+            FQTEInputEvent Event;
+            Event.Key = SnapPointProgram->Config.RequiredInput;
+            Event.Type = Entry.EventType;
+            Event.UserIndex = FirstReplayUser + static_cast<int32>(Entry.SnapPoint);
+            Event.Timestamp = Entry.Time;
+            ProcessSnapPointEvent(Handle.Index, Entry.SnapPoint, Event);
+            break;
+        }
+        case EQTERecordEntryType::HoldUpdate:
+            CreditHeldAction(Handle.Index, Entry.SnapPoint, *SnapPointProgram, Entry.Time);
+            break;
+        case EQTERecordEntryType::CueExpiry:
+            ExpireCues(Handle.Index, Entry.SnapPoint, *SnapPointProgram, Entry.Time);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Flux épuisé sans complétion : timeout ou départ d'un joueur à l'enregistrement
+    if (FindSession(Handle))
+    {
+        CompleteQTE(Handle.Index, false, EQTEFailureCause::Timeout);
+    }
+
+    OutResult = *Replayed;
+    return true;
+}
+
+bool UQTE_Subsystem::RunReplay(const FString& Path, int32 NumRuns)
+{
+    const FString FullPath = FPaths::IsRelative(Path) ? FQTERecording::GetRecordingDirectory() / Path : Path;
+
+    FQTERecording Recording;
+    if (!Recording.LoadFromFile(FullPath))
+    {
+        IBCR_Helper::LogAll(this, FString::Printf(TEXT("QTE replay: cannot read %s"), *FullPath), 10.0f, FColor::Red);
+        return false;
+    }
+
+    // Les logs par action fausseraient la mesure
+    const bool bLogActions = CVarQTELogActions.GetValueOnGameThread();
+    CVarQTELogActions->Set(false);
+
+    int32 NumMatches = 0;
+    double TotalSeconds = 0.0;
+
+    for (int32 Run = 0; Run < NumRuns; ++Run)
+    {
+        FQTERecording Result;
+        const double StartTime = FPlatformTime::Seconds();
+        const bool bReplayed = ReplayRecording(Recording, Result);
+        TotalSeconds += FPlatformTime::Seconds() - StartTime;
+
+        if (bReplayed && Result.MatchesResult(Recording))
+        {
+            ++NumMatches;
+        }
+    }
+
+    CVarQTELogActions->Set(bLogActions);
+
+    const bool bDeterministic = NumMatches == NumRuns;
+    IBCR_Helper::LogAll(this, FString::Printf(
+        TEXT("QTE replay %s: %d/%d runs match (%s), %d entries, avg %.3f ms/run"),
+        *FPaths::GetCleanFilename(FullPath), NumMatches, NumRuns, Recording.bSuccess ? TEXT("Success") : TEXT("Failure"),
+        Recording.Entries.Num(), TotalSeconds * 1000.0 / NumRuns), 10.0f, bDeterministic ? FColor::Cyan : FColor::Red);
+
+    return bDeterministic;
+}
+
+void UQTE_Subsystem::RunBenchmark(int32 NumSessions, int32 NumFrames)
+{
+#if !UE_BUILD_SHIPPING
+    // Index utilisateur hors de la plage des manettes réelles
+    constexpr int32 FirstSyntheticUser = 1000;
+    const FKey BenchmarkKey = EKeys::Gamepad_FaceButton_Bottom;
+
+    FQTEConfiguration Config;
+    Config.ConfigurationName = TEXT("Benchmark");
+    Config.InputMode = EQTEInputMode::Events;
+    for (ESnapPointType SnapPoint : { ESnapPointType::First, ESnapPointType::Second })
+    {
+        FSnapPointConfig& SnapConfig = Config.SnapPoints.AddDefaulted_GetRef();
+        SnapConfig.SnapPointType = SnapPoint;
+        SnapConfig.ActionType = EQTEActionType::Press;
+        SnapConfig.RequiredInput = BenchmarkKey;
+        SnapConfig.RepeatCount = NumFrames + 1;
+    }
+
+    // Les logs par action fausseraient la mesure
+    const bool bLogActions = CVarQTELogActions.GetValueOnGameThread();
+    CVarQTELogActions->Set(false);
+
+    const TSharedRef<const FQTEProgram> Program = FQTEProgram::Compile(Config);
+
+    TArray<FQTESessionHandle> Handles;
+    Handles.Reserve(NumSessions);
+    for (int32 SessionIndex = 0; SessionIndex < NumSessions; ++SessionIndex)
+    {
+        const FQTESessionHandle Handle = StartQTEProgram(Program);
+        Sessions[Handle.Index].TelemetryIndex = INDEX_NONE;
+        Sessions[Handle.Index].Recording.Reset();
+        OnUserEnterSnapPoint(Handle, FirstSyntheticUser + SessionIndex * 2, ESnapPointType::First);
+        OnUserEnterSnapPoint(Handle, FirstSyntheticUser + SessionIndex * 2 + 1, ESnapPointType::Second);
+        Handles.Add(Handle);
+    }
+
+    double TotalSeconds = 0.0;
+    double WorstSeconds = 0.0;
+
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        FQTEInputEvent Event;
+        Event.Key = BenchmarkKey;
+        Event.Timestamp = FPlatformTime::Seconds();
+        for (int32 User = 0; User < NumSessions * 2; ++User)
+        {
+            Event.UserIndex = FirstSyntheticUser + User;
+            PendingInputs.Add(Event);
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+        Tick(ProcessInterval);
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+        TotalSeconds += Elapsed;
+        WorstSeconds = FMath::Max(WorstSeconds, Elapsed);
+    }
+
+    for (const FQTESessionHandle& Handle : Handles)
+    {
+        StopQTE(Handle);
+    }
+    CVarQTELogActions->Set(bLogActions);
+
+    const double AverageMs = TotalSeconds * 1000.0 / NumFrames;
+    IBCR_Helper::LogAll(this, FString::Printf(
+        TEXT("QTE benchmark: %d sessions, %d frames, avg %.3f ms/frame (%.2f us/session), worst %.3f ms"),
+        NumSessions, NumFrames, AverageMs, AverageMs * 1000.0 / NumSessions, WorstSeconds * 1000.0), 10.0f, FColor::Cyan);
+#endif
+}
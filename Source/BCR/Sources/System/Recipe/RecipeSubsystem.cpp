@@ -0,0 +1,219 @@
+#include "BCR/Headers/System/Recipe/RecipeSubsystem.h"
+#include "BCR/Headers/System/Pickable/PickableItem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	uint64 MixItem(FItemTypeId Item)
+	{
+		// splitmix64 finalizer: sums of mixed ids give an order independent multiset hash
+		uint64 Value = static_cast<uint64>(Item.Value) + 0x9E3779B97F4A7C15ull;
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+
+	/* Blueprint struct members have mangled names: match on the authored name */
+	const FProperty* FindRowProperty(const UScriptStruct* RowStruct, const TCHAR* Name)
+	{
+		for (TFieldIterator<FProperty> It(RowStruct); It; ++It)
+		{
+			if (It->GetAuthoredName() == Name)
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+
+	UClass* ReadClass(const FProperty* Property, const void* Value)
+	{
+		if (const FClassProperty* ClassProperty = CastField<FClassProperty>(Property))
+		{
+			return Cast<UClass>(ClassProperty->GetObjectPropertyValue(Value));
+		}
+		if (const FSoftClassProperty* SoftClassProperty = CastField<FSoftClassProperty>(Property))
+		{
+			// Loaded once, with the table
+			return Cast<UClass>(SoftClassProperty->GetPropertyValue(Value).LoadSynchronous());
+		}
+		return nullptr;
+	}
+}
+
+void FRecipeSignature::Add(FItemTypeId Item)
+{
+	Hash += MixItem(Item);
+	++NumItems;
+}
+
+void FRecipeSignature::Remove(FItemTypeId Item)
+{
+	Hash -= MixItem(Item);
+	--NumItems;
+}
+
+URecipeSubsystem* URecipeSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<URecipeSubsystem>() : nullptr;
+}
+
+void URecipeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	ItemTypes = Collection.InitializeDependency<UItemTypeRegistry>();
+
+	LoadedTable = RecipeTable.LoadSynchronous();
+	if (LoadedTable)
+	{
+		BuildIndex(*LoadedTable);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Recipes: table %s not found"), *RecipeTable.ToString());
+	}
+}
+
+void URecipeSubsystem::Deinitialize()
+{
+	Recipes.Empty();
+	Ingredients.Empty();
+	RecipeIndex.Empty();
+	ResultClasses.Empty();
+	LoadedTable = nullptr;
+	Super::Deinitialize();
+}
+
+void URecipeSubsystem::BuildIndex(const UDataTable& Table)
+{
+	const UScriptStruct* RowStruct = Table.GetRowStruct();
+	const FArrayProperty* RecipeProperty = RowStruct ? CastField<FArrayProperty>(FindRowProperty(RowStruct, TEXT("Recipe"))) : nullptr;
+	const FProperty* ResultProperty = RowStruct ? FindRowProperty(RowStruct, TEXT("Result")) : nullptr;
+	// Optional column
+	const FNumericProperty* TimeProperty = RowStruct ? CastField<FNumericProperty>(FindRowProperty(RowStruct, TEXT("ProductionTime"))) : nullptr;
+	if (!RecipeProperty || !ResultProperty || !ItemTypes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Recipes: %s has no Recipe/Result columns"), *Table.GetName());
+		return;
+	}
+
+	const TMap<FName, uint8*>& RowMap = Table.GetRowMap();
+	Recipes.Reserve(RowMap.Num());
+	ResultClasses.Reserve(RowMap.Num());
+	RecipeIndex.Reserve(RowMap.Num());
+
+	for (const TPair<FName, uint8*>& Row : RowMap)
+	{
+		FRecipe Recipe;
+		Recipe.RowName = Row.Key;
+		UClass* ResultClass = ReadClass(ResultProperty, ResultProperty->ContainerPtrToValuePtr<void>(Row.Value));
+		Recipe.Result = ItemTypes->Resolve(ResultClass);
+		Recipe.FirstIngredient = Ingredients.Num();
+		if (TimeProperty)
+		{
+			Recipe.ProductionTime = static_cast<float>(TimeProperty->IsFloatingPoint()
+				? TimeProperty->GetFloatingPointPropertyValue(TimeProperty->ContainerPtrToValuePtr<void>(Row.Value))
+				: TimeProperty->GetSignedIntPropertyValue(TimeProperty->ContainerPtrToValuePtr<void>(Row.Value)));
+		}
+
+		FRecipeSignature Signature;
+		FScriptArrayHelper RecipeArray(RecipeProperty, RecipeProperty->ContainerPtrToValuePtr<void>(Row.Value));
+		for (int32 Index = 0; Index < RecipeArray.Num(); ++Index)
+		{
+			const FItemTypeId Item = ItemTypes->Resolve(ReadClass(RecipeProperty->Inner, RecipeArray.GetRawPtr(Index)));
+			if (Item.IsValid())
+			{
+				Ingredients.Add(Item);
+				Signature.Add(Item);
+			}
+		}
+		Recipe.NumIngredients = Ingredients.Num() - Recipe.FirstIngredient;
+
+		if (!Recipe.Result.IsValid() || Recipe.NumIngredients == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Recipes: row %s skipped (empty)"), *Row.Key.ToString());
+			Ingredients.SetNum(Recipe.FirstIngredient, EAllowShrinking::No);
+			continue;
+		}
+
+		// Canonical order for callers listing the ingredients
+		Sort(Ingredients.GetData() + Recipe.FirstIngredient, Recipe.NumIngredients, [](FItemTypeId A, FItemTypeId B) { return A.Value < B.Value; });
+
+		if (const int32* Existing = RecipeIndex.Find(Signature))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Recipes: row %s has the same ingredients as %s, ignored"), *Row.Key.ToString(), *Recipes[*Existing].RowName.ToString());
+			Ingredients.SetNum(Recipe.FirstIngredient, EAllowShrinking::No);
+			continue;
+		}
+
+		RecipeIndex.Add(Signature, Recipes.Add(Recipe));
+		ResultClasses.Add(ResultClass);
+	}
+
+	Recipes.Shrink();
+	ResultClasses.Shrink();
+	Ingredients.Shrink();
+	UE_LOG(LogTemp, Log, TEXT("Recipes: %d recipes indexed from %s"), Recipes.Num(), *Table.GetName());
+}
+
+const FRecipe* URecipeSubsystem::FindRecipe(const FRecipeSignature& Signature, TConstArrayView<FItemTypeId> Items) const
+{
+	const int32* Index = RecipeIndex.Find(Signature);
+	if (!Index)
+	{
+		return nullptr;
+	}
+
+	// Different multisets can share a hash: the ingredients are stored sorted, compare a sorted copy
+	const FRecipe& Recipe = Recipes[*Index];
+	if (Items.Num() != Recipe.NumIngredients)
+	{
+		return nullptr;
+	}
+
+	TArray<FItemTypeId, TInlineAllocator<16>> SortedItems(Items);
+	SortedItems.Sort([](FItemTypeId A, FItemTypeId B) { return A.Value < B.Value; });
+	for (int32 Item = 0; Item < Recipe.NumIngredients; ++Item)
+	{
+		if (SortedItems[Item] != Ingredients[Recipe.FirstIngredient + Item])
+		{
+			return nullptr;
+		}
+	}
+	return &Recipe;
+}
+
+TSubclassOf<APickableItem> URecipeSubsystem::GetResultClass(const FRecipe& Recipe) const
+{
+	const int32 Index = UE_PTRDIFF_TO_INT32(&Recipe - Recipes.GetData());
+	check(ResultClasses.IsValidIndex(Index));
+	return ResultClasses[Index];
+}
+
+TSubclassOf<APickableItem> URecipeSubsystem::FindRecipeResult(const TArray<TSubclassOf<APickableItem>>& InIngredients) const
+{
+	if (!ItemTypes)
+	{
+		return nullptr;
+	}
+
+	// Same filtering as BuildIndex: unresolved classes are not ingredients
+	FRecipeSignature Signature;
+	TArray<FItemTypeId, TInlineAllocator<16>> Items;
+	for (const TSubclassOf<APickableItem>& Ingredient : InIngredients)
+	{
+		const FItemTypeId Item = ItemTypes->Resolve(Ingredient);
+		if (Item.IsValid())
+		{
+			Signature.Add(Item);
+			Items.Add(Item);
+		}
+	}
+
+	const FRecipe* Recipe = FindRecipe(Signature, Items);
+	return Recipe ? GetResultClass(*Recipe) : nullptr;
+}
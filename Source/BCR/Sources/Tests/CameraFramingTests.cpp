@@ -0,0 +1,162 @@
+#include "BCR/Headers/System/CameraFraming.h"
+#include "Algo/Reverse.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CameraFramingTests
+{
+	constexpr float HorizontalFOV = 90.f;
+	constexpr float VerticalFOV = 58.7f;
+	constexpr float HorizontalBuffer = 200.f;
+	constexpr float VerticalBuffer = 400.f;
+	constexpr float MinimumArmLength = 4000.f;
+
+	/* Same axes as AMainCamera::UpdateFraming for a camera with this pitch and no yaw */
+	FCameraFramingSettings MakeSettings(float Pitch)
+	{
+		const FRotator Rotation(Pitch, 0.f, 0.f);
+		FCameraFramingSettings Settings;
+		Settings.RightAxis = FRotationMatrix(Rotation).GetUnitAxis(EAxis::Y);
+		Settings.BackAxis = (-Rotation.Vector()).RotateAngleAxis(Pitch, Settings.RightAxis);
+		Settings.Pitch = Pitch;
+		Settings.HorizontalFOV = HorizontalFOV;
+		Settings.VerticalFOV = VerticalFOV;
+		Settings.HorizontalBuffer = HorizontalBuffer;
+		Settings.VerticalBuffer = VerticalBuffer;
+		Settings.MinimumArmLength = MinimumArmLength;
+		return Settings;
+	}
+
+	/* Arm length of two players, as AMainCamera::UpdateArmLenght computed it before FCameraFraming */
+	float LegacyArmLength(const FVector& Player0, const FVector& Player1, float Pitch)
+	{
+		const FRotator Rotation(Pitch, 0.f, 0.f);
+		const FVector RightVector = FRotationMatrix(Rotation).GetUnitAxis(EAxis::Y);
+		const FVector PlayerDistVec = Player0 - Player1;
+
+		const float PlayerDistHor = FMath::Abs(FVector2D::DotProduct(FVector2D(RightVector).GetSafeNormal(), FVector2D(PlayerDistVec)));
+		const float EdgeDistHor = (PlayerDistHor / 2) + HorizontalBuffer;
+		const float TotalArmLengthHor = EdgeDistHor / FMath::Tan(FMath::DegreesToRadians(HorizontalFOV / 2));
+
+		const FVector BackVector = (-Rotation.Vector()).RotateAngleAxis(Pitch, RightVector);
+		const float PlayerDistVer = FMath::Abs(FVector2D::DotProduct(FVector2D(BackVector).GetSafeNormal(), FVector2D(PlayerDistVec)));
+		const float EdgeDistVer = (PlayerDistVer / 2) + VerticalBuffer;
+		const float TotalArmLengthVer = FMath::Sin(FMath::DegreesToRadians(-Pitch)) * EdgeDistVer / FMath::Tan(FMath::DegreesToRadians(VerticalFOV / 2))
+			+ FMath::Cos(FMath::DegreesToRadians(-Pitch)) * EdgeDistVer;
+
+		return FMath::Max3(TotalArmLengthHor, TotalArmLengthVer, MinimumArmLength);
+	}
+
+	/* Farthest point from the centroid along an axis, by brute force */
+	double MaxOffset(TConstArrayView<FVector4> Points, const FVector& Centroid, const FVector& Axis)
+	{
+		const FVector2D Ground = FVector2D(Axis).GetSafeNormal();
+		double Offset = 0.0;
+		for (const FVector4& Point : Points)
+		{
+			Offset = FMath::Max(Offset, FMath::Abs(FVector2D::DotProduct(Ground, FVector2D(FVector(Point) - Centroid))));
+		}
+		return Offset;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraFramingTwoPlayersTest, "BCR.Camera.Framing.TwoPlayers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCameraFramingTwoPlayersTest::RunTest(const FString& Parameters)
+{
+	using namespace CameraFramingTests;
+
+	const TPair<FVector, FVector> Pairs[] = {
+		{ FVector(0.f, 0.f, 0.f), FVector(0.f, 0.f, 0.f) },
+		{ FVector(0.f, -1500.f, 0.f), FVector(0.f, 1500.f, 0.f) },
+		{ FVector(-4000.f, 200.f, 50.f), FVector(3000.f, -100.f, 0.f) },
+		{ FVector(1200.f, 9000.f, 0.f), FVector(-7000.f, -8000.f, 300.f) },
+		{ FVector(-250.f, 330.f, -80.f), FVector(410.f, -120.f, 120.f) },
+	};
+	const float Pitches[] = { -10.f, -15.f, -20.f };
+
+	for (const float Pitch : Pitches)
+	{
+		const FCameraFramingSettings Settings = MakeSettings(Pitch);
+		for (const TPair<FVector, FVector>& Pair : Pairs)
+		{
+			const FVector4 Points[] = { FVector4(Pair.Key, 1.f), FVector4(Pair.Value, 1.f) };
+			const FCameraFramingResult Result = FCameraFraming::Solve(Points, Settings);
+
+			const FString Context = FString::Printf(TEXT("pitch %.0f, %s / %s"), Pitch, *Pair.Key.ToString(), *Pair.Value.ToString());
+			const float Expected = LegacyArmLength(Pair.Key, Pair.Value, Pitch);
+			TestNearlyEqual(*FString::Printf(TEXT("Arm length (%s)"), *Context), Result.ArmLength, Expected, Expected * 1e-4f);
+			TestTrue(*FString::Printf(TEXT("Centroid is the midpoint (%s)"), *Context), Result.Centroid.Equals((Pair.Key + Pair.Value) * 0.5, 0.01));
+		}
+	}
+
+	// No point: the minimum arm length, as before
+	const FCameraFramingResult Empty = FCameraFraming::Solve(TConstArrayView<FVector4>(), MakeSettings(-10.f));
+	TestEqual(TEXT("Arm length without points"), Empty.ArmLength, MinimumArmLength);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraFramingWeightedPointsTest, "BCR.Camera.Framing.WeightedPoints",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCameraFramingWeightedPointsTest::RunTest(const FString& Parameters)
+{
+	using namespace CameraFramingTests;
+
+	const FCameraFramingSettings Settings = MakeSettings(-15.f);
+	const float TanHalfHorizontal = FMath::Tan(FMath::DegreesToRadians(HorizontalFOV / 2));
+
+	// Four players and a machine pulling the centroid toward it
+	TArray<FVector4> Points = {
+		FVector4(-3000.f, -2500.f, 0.f, 1.f),
+		FVector4(2500.f, -1000.f, 100.f, 1.f),
+		FVector4(800.f, 6000.f, 0.f, 1.f),
+		FVector4(-1200.f, 2200.f, -50.f, 1.f),
+		FVector4(9000.f, 9000.f, 0.f, 3.f),
+	};
+
+	const FCameraFramingResult Result = FCameraFraming::Solve(Points, Settings);
+
+	FVector WeightedSum = FVector::ZeroVector;
+	double TotalWeight = 0.0;
+	for (const FVector4& Point : Points)
+	{
+		WeightedSum += FVector(Point) * Point.W;
+		TotalWeight += Point.W;
+	}
+	TestTrue(TEXT("Centroid is the weighted average"), Result.Centroid.Equals(WeightedSum / TotalWeight, 0.01));
+
+	// The camera looks at the centroid: the farthest point on each side must fit, whatever its weight
+	const double HalfRight = MaxOffset(Points, Result.Centroid, Settings.RightAxis);
+	TestNearlyEqual(TEXT("Horizontal arm length fits the farthest point"),
+		Result.HorizontalArmLength, static_cast<float>((HalfRight + HorizontalBuffer) / TanHalfHorizontal), 0.5f);
+	TestTrue(TEXT("Arm length covers both FOVs and the minimum"),
+		Result.ArmLength >= Result.HorizontalArmLength && Result.ArmLength >= Result.VerticalArmLength && Result.ArmLength >= MinimumArmLength);
+
+	// Order independent
+	TArray<FVector4> Reversed(Points);
+	Algo::Reverse(Reversed);
+	const FCameraFramingResult ReversedResult = FCameraFraming::Solve(Reversed, Settings);
+	TestNearlyEqual(TEXT("Arm length does not depend on the point order"), ReversedResult.ArmLength, Result.ArmLength, 0.01f);
+
+	// A heavier weight moves the centroid, never lets a point leave the screen
+	Points.Last().W = 0.f;
+	const FCameraFramingResult Unweighted = FCameraFraming::Solve(Points, Settings);
+	TestTrue(TEXT("A zero weight point does not pull the centroid"), Unweighted.Centroid.X < Result.Centroid.X && Unweighted.Centroid.Y < Result.Centroid.Y);
+	TestNearlyEqual(TEXT("A zero weight point is still framed"), Unweighted.HorizontalSpread, Result.HorizontalSpread, 0.01f);
+
+	// Every weight at zero: the middle of the points
+	for (FVector4& Point : Points)
+	{
+		Point.W = 0.f;
+	}
+	const FCameraFramingResult NoWeight = FCameraFraming::Solve(Points, Settings);
+	TestTrue(TEXT("Without weights the arm length is still finite"), FMath::IsFinite(NoWeight.ArmLength) && NoWeight.ArmLength >= MinimumArmLength);
+
+	return true;
+}
+
+#endif
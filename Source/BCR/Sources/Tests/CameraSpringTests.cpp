@@ -0,0 +1,135 @@
+#include "BCR/Headers/System/CameraSpring.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CameraSpringTests
+{
+	constexpr float SmoothTime = 0.3f;
+	constexpr float MaxSubstep = 1.f / 30.f;
+
+	/* Target of the camera at time T: a jump at 0, then a steady walk from 0.5 s */
+	float TargetAt(double Time)
+	{
+		return Time < 0.5 ? 1000.f : 1000.f + 600.f * static_cast<float>(Time - 0.5);
+	}
+
+	/* Value of a spring stepped with these frame times, sampled every SampleEvery seconds (frames must land on samples) */
+	TArray<float> Run(TConstArrayView<float> FrameTimes, double SampleEvery, float Substep)
+	{
+		TCameraSpring<float> Spring;
+		Spring.Snap(0.f);
+
+		TArray<float> Samples;
+		double Time = 0.0;
+		double NextSample = SampleEvery;
+		for (const float FrameTime : FrameTimes)
+		{
+			Time += FrameTime;
+			Spring.Update(TargetAt(Time), SmoothTime, FrameTime, Substep);
+			if (Time >= NextSample - UE_KINDA_SMALL_NUMBER)
+			{
+				Samples.Add(Spring.Value);
+				NextSample += SampleEvery;
+			}
+		}
+		return Samples;
+	}
+
+	TArray<float> FixedFrames(float FrameTime, double Duration)
+	{
+		TArray<float> FrameTimes;
+		FrameTimes.Init(FrameTime, FMath::RoundToInt32(Duration / FrameTime));
+		return FrameTimes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraSpringFrameRateTest, "BCR.Camera.Spring.FrameRate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCameraSpringFrameRateTest::RunTest(const FString& Parameters)
+{
+	using namespace CameraSpringTests;
+
+	// Every 1/6 s lands on a frame at 30, 60 and 144 FPS
+	constexpr double SampleEvery = 1.0 / 6.0;
+	constexpr double Duration = 2.0;
+
+	// Fixed target: closed form, the frame rate does not matter at all
+	{
+		TArray<float> Reference;
+		for (const int32 FPS : { 30, 60, 144 })
+		{
+			TCameraSpring<float> Spring;
+			Spring.Snap(0.f);
+			for (int32 Frame = 0; Frame < FPS; ++Frame)
+			{
+				Spring.Update(1000.f, SmoothTime, 1.f / FPS);
+			}
+			Reference.Add(Spring.Value);
+		}
+		TestNearlyEqual(TEXT("Fixed target, 30 vs 144 FPS after 1 s"), Reference[0], Reference[2], 0.05f);
+		TestNearlyEqual(TEXT("Fixed target, 60 vs 144 FPS after 1 s"), Reference[1], Reference[2], 0.05f);
+	}
+
+	// Moving target: the target is only sampled once per frame, trajectories stay within a few units
+	const TArray<float> At144 = Run(FixedFrames(1.f / 144.f, Duration), SampleEvery, 0.f);
+	for (const int32 FPS : { 30, 60 })
+	{
+		const TArray<float> Samples = Run(FixedFrames(1.f / FPS, Duration), SampleEvery, 0.f);
+		if (!TestEqual(*FString::Printf(TEXT("%d FPS sample count"), FPS), Samples.Num(), At144.Num()))
+		{
+			continue;
+		}
+		for (int32 Sample = 0; Sample < Samples.Num(); ++Sample)
+		{
+			TestNearlyEqual(*FString::Printf(TEXT("%d vs 144 FPS at %.2f s"), FPS, (Sample + 1) * SampleEvery), Samples[Sample], At144[Sample], 10.f);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraSpringHitchTest, "BCR.Camera.Spring.Hitch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCameraSpringHitchTest::RunTest(const FString& Parameters)
+{
+	using namespace CameraSpringTests;
+
+	// 60 FPS with a 250 ms hitch at 1 s, against a steady 60 FPS
+	constexpr float FrameTime = 1.f / 60.f;
+	TArray<float> Hitched = FixedFrames(FrameTime, 1.0);
+	Hitched.Add(0.25f);
+	Hitched.Append(FixedFrames(FrameTime, 0.75));
+
+	const TArray<float> Steady = FixedFrames(FrameTime, 2.0);
+	constexpr double SampleEvery = 0.25;
+
+	const TArray<float> Reference = Run(Steady, SampleEvery, MaxSubstep);
+	const TArray<float> Substepped = Run(Hitched, SampleEvery, MaxSubstep);
+	const TArray<float> SingleStep = Run(Hitched, SampleEvery, 0.f);
+	if (!TestEqual(TEXT("Sample count"), Substepped.Num(), Reference.Num()) || !TestEqual(TEXT("Sample count"), SingleStep.Num(), Reference.Num()))
+	{
+		return false;
+	}
+
+	// The hitch lands on the 1.25 s sample: substeps interpolate the walking target, one step jumps to its end
+	float SubstepError = 0.f;
+	float SingleStepError = 0.f;
+	for (int32 Sample = 0; Sample < Reference.Num(); ++Sample)
+	{
+		SubstepError = FMath::Max(SubstepError, FMath::Abs(Substepped[Sample] - Reference[Sample]));
+		SingleStepError = FMath::Max(SingleStepError, FMath::Abs(SingleStep[Sample] - Reference[Sample]));
+	}
+	TestTrue(*FString::Printf(TEXT("Substepped hitch follows the steady trajectory (error %.2f)"), SubstepError), SubstepError < 5.f);
+	TestTrue(*FString::Printf(TEXT("Substeps are closer than a single step (%.2f vs %.2f)"), SubstepError, SingleStepError), SubstepError < SingleStepError);
+
+	// Nothing overshoots or diverges after the hitch
+	TestTrue(TEXT("Value stays finite"), FMath::IsFinite(Substepped.Last()));
+	TestTrue(TEXT("No overshoot past the target"), Substepped.Last() <= TargetAt(2.0));
+
+	return true;
+}
+
+#endif
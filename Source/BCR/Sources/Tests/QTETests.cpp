@@ -0,0 +1,186 @@
+﻿#include "BCR/Headers/System/QTE/QTE_Subsystem.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace QTETests
+{
+    // Index utilisateur hors de la plage des manettes, du benchmark et du rejeu
+    constexpr int32 TestUser = 3000;
+
+    UQTE_Subsystem* CreateSubsystem()
+    {
+        // Sous-système isolé : ni monde, ni widget, ni Slate (entrées injectées via QueueInputEvent)
+        UGameInstance* GameInstance = NewObject<UGameInstance>(GetTransientPackage());
+        return NewObject<UQTE_Subsystem>(GameInstance);
+    }
+
+    void QueuePress(UQTE_Subsystem* QTESystem, const FKey& Key)
+    {
+        FQTEInputEvent Event;
+        Event.Key = Key;
+        Event.Type = EQTEInputEventType::Pressed;
+        Event.UserIndex = TestUser;
+        Event.Timestamp = FPlatformTime::Seconds();
+        QTESystem->QueueInputEvent(Event);
+    }
+
+    FSnapPointConfig MakePress(const FKey& Key, int32 RepeatCount)
+    {
+        FSnapPointConfig SnapConfig;
+        SnapConfig.SnapPointType = ESnapPointType::First;
+        SnapConfig.ActionType = EQTEActionType::Press;
+        SnapConfig.RequiredInput = Key;
+        SnapConfig.RepeatCount = RepeatCount;
+        return SnapConfig;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQTEInputEventsTest, "BCR.QTE.InputEvents",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQTEInputEventsTest::RunTest(const FString& Parameters)
+{
+    using namespace QTETests;
+    const FKey Key = EKeys::Gamepad_FaceButton_Bottom;
+
+    // 40 appuis par seconde : plusieurs par frame à 20 Hz, des frames sans appui à 240 Hz
+    constexpr int32 NumPresses = 50;
+    constexpr double PressInterval = 0.025;
+
+    FQTEConfiguration Config;
+    Config.ConfigurationName = TEXT("InputEvents");
+    Config.InputMode = EQTEInputMode::Events;
+    Config.SnapPoints.Add(MakePress(Key, NumPresses));
+
+    for (const int32 FrameRate : { 20, 60, 240 })
+    {
+        UQTE_Subsystem* QTESystem = CreateSubsystem();
+        const FQTESessionHandle Handle = QTESystem->StartQTE(Config);
+        QTESystem->OnUserEnterSnapPoint(Handle, TestUser, ESnapPointType::First);
+
+        bool bCompleted = false;
+        bool bSucceeded = false;
+        QTESystem->GetSessionDelegates(Handle)->OnComplete.AddLambda([&](FQTESessionHandle, bool bSuccess)
+        {
+            bCompleted = true;
+            bSucceeded = bSuccess;
+        });
+
+        const double DeltaTime = 1.0 / FrameRate;
+        int32 NumQueued = 0;
+
+        for (int32 Frame = 0; NumQueued < NumPresses; ++Frame)
+        {
+            // Appuis tombés pendant la frame, suivis de leur relâchement
+            const double FrameEnd = (Frame + 1) * DeltaTime;
+            while (NumQueued < NumPresses && NumQueued * PressInterval < FrameEnd)
+            {
+                QueuePress(QTESystem, Key);
+
+                FQTEInputEvent Release;
+                Release.Key = Key;
+                Release.Type = EQTEInputEventType::Released;
+                Release.UserIndex = TestUser;
+                Release.Timestamp = FPlatformTime::Seconds();
+                QTESystem->QueueInputEvent(Release);
+                ++NumQueued;
+            }
+
+            // Aucun appui compté deux fois : la session ne peut finir qu'avec le dernier
+            TestFalse(FString::Printf(TEXT("%d Hz: completed before the last press"), FrameRate), bCompleted);
+            QTESystem->Tick(static_cast<float>(DeltaTime));
+        }
+
+        // Aucun appui perdu : le dernier termine la session dans la frame où il est reçu
+        TestTrue(FString::Printf(TEXT("%d Hz: every press counted"), FrameRate), bCompleted && bSucceeded);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQTEReplayMissedCueTest, "BCR.QTE.ReplayMissedCue",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQTEReplayMissedCueTest::RunTest(const FString& Parameters)
+{
+    using namespace QTETests;
+    const FKey Key = EKeys::Gamepad_FaceButton_Bottom;
+    constexpr float DeltaTime = 1.0f / 60.0f;
+
+    // Deux repères, le second est manqué : l'échec MissedCues, constaté par le tick, mène à l'étape de rattrapage
+    FQTEConfiguration Config;
+    Config.ConfigurationName = TEXT("ReplayMissedCue");
+    Config.InputMode = EQTEInputMode::Events;
+
+    FQTEStageConfig& Cues = Config.Stages.AddDefaulted_GetRef();
+    Cues.StageName = TEXT("Cues");
+    Cues.OnFailure = TEXT("Recover");
+    FSnapPointConfig& Timed = Cues.SnapPoints.Add_GetRef(MakePress(Key, 2));
+    Timed.CueTimes = { 0.5f, 1.0f };
+
+    FQTEStageConfig& Recover = Config.Stages.AddDefaulted_GetRef();
+    Recover.StageName = TEXT("Recover");
+    Recover.SnapPoints.Add(MakePress(Key, 1));
+
+    UQTE_Subsystem* QTESystem = CreateSubsystem();
+
+    IConsoleVariable* RecordVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("QTE.Record"));
+    const bool bWasRecording = RecordVariable->GetBool();
+    RecordVariable->Set(true);
+
+    FQTERecording Live;
+    QTESystem->OnRecordingFinished.AddLambda([&Live](const FQTERecording& Recording) { Live = Recording; });
+
+    const FQTESessionHandle Handle = QTESystem->StartQTE(Config);
+    QTESystem->OnUserEnterSnapPoint(Handle, TestUser, ESnapPointType::First);
+    RecordVariable->Set(bWasRecording);
+
+    // Appui sur le premier repère, aucun sur le second, puis appui de rattrapage
+    for (int32 Frame = 0; Frame < 120 && QTESystem->IsSessionRunning(Handle); ++Frame)
+    {
+        if (Frame == 30 || Frame == 90)
+        {
+            QueuePress(QTESystem, Key);
+        }
+        QTESystem->Tick(DeltaTime);
+    }
+
+    TestFalse(TEXT("Session finished"), QTESystem->IsSessionRunning(Handle));
+    TestTrue(TEXT("Live session recovered after the missed cue"), Live.bSuccess);
+    TestTrue(TEXT("Tick-time miss recorded"), Live.Entries.ContainsByPredicate([](const FQTERecordEntry& Entry) { return Entry.Type == EQTERecordEntryType::CueExpiry; }));
+
+    // Aller-retour par le format binaire, comme un fichier de Saved/QTE
+    TArray<uint8> Buffer;
+    FMemoryWriter Writer(Buffer);
+    Writer << Live;
+    FQTERecording Loaded;
+    FMemoryReader Reader(Buffer);
+    Reader << Loaded;
+    TestFalse(TEXT("Recording round trip"), Reader.IsError());
+
+    for (int32 Run = 0; Run < 3; ++Run)
+    {
+        FQTERecording Replayed;
+        TestTrue(TEXT("Replay started"), QTESystem->ReplayRecording(Loaded, Replayed));
+        TestTrue(TEXT("Replay matches the live result"), Replayed.MatchesResult(Live));
+
+        // Même chaîne d'entrées : mêmes types, mêmes instants
+        if (TestEqual(TEXT("Replayed entries"), Replayed.Entries.Num(), Live.Entries.Num()))
+        {
+            for (int32 Index = 0; Index < Live.Entries.Num(); ++Index)
+            {
+                TestTrue(FString::Printf(TEXT("Entry %d type"), Index), Replayed.Entries[Index].Type == Live.Entries[Index].Type);
+                TestEqual(FString::Printf(TEXT("Entry %d time"), Index), Replayed.Entries[Index].Time, Live.Entries[Index].Time);
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif